@@ -0,0 +1,397 @@
+#include "bench.h"
+
+#include "images.h"
+#include "videos.h"
+#include "fonts/utf8-utils.h"
+
+#define DEBUG_BENCH false
+
+//sample text (ASCII and Latin-1)
+static const char *benchText = "The quick brown fox jumps over the lazy dog. Größe, Straße und Ärger! 0123456789 (+-*/) [AV To WA]";
+
+static volatile GLfloat benchSink;
+
+//
+// BenchEventObject
+//
+
+/**
+ * Event object feeding the async queue benchmark.
+ */
+class BenchEventObject : public AminoJSEventObject {
+public:
+    int applied = 0;
+
+    BenchEventObject(): AminoJSEventObject("BenchEventObject") {
+        //empty
+    }
+
+    /**
+     * Wrap in a plain JS object (needed for retain/release).
+     */
+    void wrap() {
+        v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>();
+
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+        v8::Local<v8::Object> obj = Nan::NewInstance(Nan::GetFunction(tpl).ToLocalChecked()).ToLocalChecked();
+
+        Wrap(obj);
+    }
+
+    /**
+     * Enqueue value updates.
+     */
+    void enqueue(int count) {
+        for (int i = 0; i < count; i++) {
+            AminoJSObject::enqueueValueUpdate(i, NULL, static_cast<asyncValueCallback>(&BenchEventObject::applyValue));
+        }
+    }
+
+    /**
+     * Apply all updates and free them.
+     */
+    void process() {
+        processAsyncQueue();
+        handleAsyncDeletes();
+    }
+
+    void destroy() override {
+        clearAsyncQueue();
+        AminoJSEventObject::destroy();
+    }
+
+private:
+    void applyValue(AsyncValueUpdate *update, int state) {
+        if (state == AsyncValueUpdate::STATE_APPLY) {
+            applied++;
+        }
+    }
+};
+
+//
+// AminoBench
+//
+
+/**
+ * Add benchmark methods.
+ */
+NAN_MODULE_INIT(AminoBench::Init) {
+    Nan::SetMethod(target, "run", Run);
+}
+
+/**
+ * Run all benchmarks.
+ *
+ * Options: iterations, font (TTF file), images (object with buffers), video (file).
+ */
+NAN_METHOD(AminoBench::Run) {
+    v8::Local<v8::Object> options = info.Length() > 0 && info[0]->IsObject() ? info[0]->ToObject() : Nan::New<v8::Object>();
+    v8::Local<v8::Array> results = Nan::New<v8::Array>();
+
+    //iterations
+    int iterations = 100000;
+    v8::Local<v8::Value> iterationsValue = Nan::Get(options, Nan::New("iterations").ToLocalChecked()).ToLocalChecked();
+
+    if (iterationsValue->IsNumber()) {
+        iterations = iterationsValue->Int32Value();
+    }
+
+    //CPU only
+    benchMatrix(results, iterations * 10);
+    benchAtlas(results, iterations);
+    benchAsyncQueue(results, iterations);
+
+    //font
+    v8::Local<v8::Value> fontValue = Nan::Get(options, Nan::New("font").ToLocalChecked()).ToLocalChecked();
+
+    if (fontValue->IsString()) {
+        std::string fontFile = AminoJSObject::toString(fontValue);
+
+        benchFont(results, iterations, fontFile);
+    }
+
+    //images
+    v8::Local<v8::Value> imagesValue = Nan::Get(options, Nan::New("images").ToLocalChecked()).ToLocalChecked();
+
+    if (imagesValue->IsObject()) {
+        v8::Local<v8::Object> images = imagesValue->ToObject();
+        v8::Local<v8::Array> names = Nan::GetOwnPropertyNames(images).ToLocalChecked();
+
+        for (uint32_t i = 0; i < names->Length(); i++) {
+            v8::Local<v8::Value> nameValue = Nan::Get(names, i).ToLocalChecked();
+            v8::Local<v8::Value> bufferObj = Nan::Get(images, nameValue).ToLocalChecked();
+            std::string name = AminoJSObject::toString(nameValue);
+
+            if (node::Buffer::HasInstance(bufferObj)) {
+                benchImage(results, std::max(iterations / 1000, 10), name, bufferObj);
+            }
+        }
+    }
+
+    //video
+    v8::Local<v8::Value> videoValue = Nan::Get(options, Nan::New("video").ToLocalChecked()).ToLocalChecked();
+
+    if (videoValue->IsString()) {
+        std::string videoFile = AminoJSObject::toString(videoValue);
+
+        benchVideo(results, std::max(iterations / 1000, 10), videoFile);
+    }
+
+    info.GetReturnValue().Set(results);
+}
+
+/**
+ * Add a result entry.
+ */
+void AminoBench::addResult(v8::Local<v8::Array> &results, std::string name, int iterations, double ms) {
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    Nan::Set(obj, Nan::New("name").ToLocalChecked(), Nan::New(name).ToLocalChecked());
+    Nan::Set(obj, Nan::New("iterations").ToLocalChecked(), Nan::New(iterations));
+    Nan::Set(obj, Nan::New("nsPerOp").ToLocalChecked(), Nan::New(iterations > 0 ? ms * 1e6 / iterations:0));
+
+    Nan::Set(results, results->Length(), obj);
+
+    if (DEBUG_BENCH) {
+        printf("%s: %.2f ns\n", name.c_str(), iterations > 0 ? ms * 1e6 / iterations:0);
+    }
+}
+
+/**
+ * Matrix operations.
+ */
+void AminoBench::benchMatrix(v8::Local<v8::Array> &results, int iterations) {
+    GLfloat a[16], b[16], p[16];
+
+    make_node_matrix(10, 20, 0, 1.5f, 0.5f, 0, 0, 30, 5, 5, a);
+    make_node_matrix(-5, 3, 0, 1, 1, 0, 0, 45, 0, 0, b);
+
+    // 1) multiplication
+    double start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        mul_matrix_scalar(p, a, b);
+        benchSink = p[i & 15];
+    }
+
+    addResult(results, "mul_matrix_scalar", iterations, getTime() - start);
+
+    start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        mul_matrix(p, a, b);
+        benchSink = p[i & 15];
+    }
+
+    addResult(results, "mul_matrix", iterations, getTime() - start);
+
+    start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        mul_matrix_affine(p, a, b);
+        benchSink = p[i & 15];
+    }
+
+    addResult(results, "mul_matrix_affine", iterations, getTime() - start);
+
+    // 2) node matrix
+    start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        make_node_matrix(1, 2, 3, 2, 3, i & 255, 45, 30, 4, 5, p);
+        benchSink = p[i & 15];
+    }
+
+    addResult(results, "make_node_matrix", iterations, getTime() - start);
+}
+
+/**
+ * Texture atlas packing.
+ */
+void AminoBench::benchAtlas(v8::Local<v8::Array> &results, int iterations) {
+    texture_atlas_t *atlas = texture_atlas_new(1024, 1024, 1);
+    int regions = 0;
+    double start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        ivec4 region = texture_atlas_get_region(atlas, 8 + (i * 7) % 24, 10 + (i * 13) % 20);
+
+        //full
+        if (region.x < 0) {
+            texture_atlas_clear(atlas);
+        }
+
+        regions++;
+    }
+
+    addResult(results, "texture_atlas_get_region", regions, getTime() - start);
+
+    texture_atlas_delete(atlas);
+}
+
+/**
+ * Glyph loading, lookup and text layout.
+ */
+void AminoBench::benchFont(v8::Local<v8::Array> &results, int iterations, std::string &fontFile) {
+    FT_Library library;
+
+    if (FT_Init_FreeType(&library)) {
+        return;
+    }
+
+    texture_atlas_t *atlas = texture_atlas_new(1024, 1024, 1);
+    size_t len = utf8_strlen(benchText);
+
+    // 1) glyph rendering (new font per pass)
+    int loops = std::max(iterations / 10000, 5);
+    int count = 0;
+    double start = getTime();
+
+    for (int i = 0; i < loops; i++) {
+        texture_font_t *font = texture_font_new_from_file(atlas, 20 + i % 2, fontFile.c_str(), library);
+
+        if (!font) {
+            texture_atlas_delete(atlas);
+            FT_Done_FreeType(library);
+
+            return;
+        }
+
+        const char *pos = benchText;
+
+        for (size_t j = 0; j < len; j++) {
+            texture_font_get_glyph(font, pos);
+            pos += utf8_surrogate_len(pos);
+            count++;
+        }
+
+        texture_font_delete(font);
+        texture_atlas_clear(atlas);
+    }
+
+    addResult(results, "texture_font_get_glyph (load)", count, getTime() - start);
+
+    // 2) cached glyphs
+    texture_font_t *font = texture_font_new_from_file(atlas, 20, fontFile.c_str(), library);
+
+    assert(font);
+    texture_font_load_glyphs(font, benchText);
+
+    count = 0;
+    start = getTime();
+
+    for (int i = 0; count < iterations; i++) {
+        const char *pos = benchText;
+
+        for (size_t j = 0; j < len; j++) {
+            texture_font_get_glyph(font, pos);
+            pos += utf8_surrogate_len(pos);
+            count++;
+        }
+    }
+
+    addResult(results, "texture_font_get_glyph (cached)", count, getTime() - start);
+
+    // 3) layout
+    vertex_buffer_t *buffer = vertex_buffer_new("pos:3f,texCoord:2f");
+
+    loops = std::max(iterations / 100, 10);
+    start = getTime();
+
+    for (int i = 0; i < loops; i++) {
+        vec2 pen = {{ 0, 0 }};
+        int lineNr;
+        float lineW;
+
+        vertex_buffer_clear(buffer);
+        AminoText::addTextGlyphs(buffer, font, benchText, &pen, AminoText::WRAP_WORD, 200, &lineNr, 0, &lineW);
+    }
+
+    addResult(results, "AminoText::addTextGlyphs", loops, getTime() - start);
+
+    //cleanup
+    vertex_buffer_delete(buffer);
+    texture_font_delete(font);
+    texture_atlas_delete(atlas);
+    FT_Done_FreeType(library);
+}
+
+/**
+ * PNG and JPEG decoding.
+ */
+void AminoBench::benchImage(v8::Local<v8::Array> &results, int iterations, std::string &name, v8::Local<v8::Value> &bufferObj) {
+    char *data = node::Buffer::Data(bufferObj);
+    size_t len = node::Buffer::Length(bufferObj);
+    int w, h, bpp;
+    double start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        if (!AminoImage::decodeImage(data, len, w, h, bpp)) {
+            return;
+        }
+    }
+
+    addResult(results, "decodeImage (" + name + ")", iterations, getTime() - start);
+}
+
+/**
+ * Video frame decoding.
+ */
+void AminoBench::benchVideo(v8::Local<v8::Array> &results, int iterations, std::string &videoFile) {
+    VideoDemuxer *demuxer = new VideoDemuxer();
+
+    if (!demuxer->init() || !demuxer->loadFile(videoFile, "") || !demuxer->initStream()) {
+        printf("could not open video: %s\n", demuxer->getLastError().c_str());
+        delete demuxer;
+
+        return;
+    }
+
+    int frames = 0;
+    double time;
+    double start = getTime();
+
+    for (int i = 0; i < iterations; i++) {
+        READ_FRAME_RESULT res = demuxer->readRGBFrame(time);
+
+        if (res == READ_END_OF_VIDEO) {
+            if (!demuxer->rewindRGB(time)) {
+                break;
+            }
+        } else if (res != READ_OK) {
+            break;
+        }
+
+        frames++;
+    }
+
+    addResult(results, "VideoDemuxer::readRGBFrame", frames, getTime() - start);
+
+    delete demuxer;
+}
+
+/**
+ * Async queue (enqueue, apply and free).
+ *
+ * Note: runs producer and consumer on the main thread.
+ */
+void AminoBench::benchAsyncQueue(v8::Local<v8::Array> &results, int iterations) {
+    BenchEventObject *obj = new BenchEventObject();
+
+    obj->wrap();
+    obj->retain();
+
+    double start = getTime();
+    int batch = 1000;
+
+    for (int i = 0; i < iterations; i += batch) {
+        obj->enqueue(batch);
+        obj->process();
+    }
+
+    addResult(results, "async queue", obj->applied, getTime() - start);
+
+    obj->destroy();
+    obj->release();
+}
@@ -0,0 +1,30 @@
+#ifndef _AMINOBENCH_H
+#define _AMINOBENCH_H
+
+#include "base.h"
+
+/**
+ * Native microbenchmarks.
+ *
+ * Times the rendering hot paths without a display (see bench/run.js).
+ */
+class AminoBench {
+public:
+    //init
+    static NAN_MODULE_INIT(Init);
+
+private:
+    //JS methods
+    static NAN_METHOD(Run);
+
+    static void addResult(v8::Local<v8::Array> &results, std::string name, int iterations, double ms);
+
+    static void benchMatrix(v8::Local<v8::Array> &results, int iterations);
+    static void benchAtlas(v8::Local<v8::Array> &results, int iterations);
+    static void benchFont(v8::Local<v8::Array> &results, int iterations, std::string &fontFile);
+    static void benchImage(v8::Local<v8::Array> &results, int iterations, std::string &name, v8::Local<v8::Value> &bufferObj);
+    static void benchVideo(v8::Local<v8::Array> &results, int iterations, std::string &videoFile);
+    static void benchAsyncQueue(v8::Local<v8::Array> &results, int iterations);
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * Matrix microbenchmark.
+ *
+ * Compares the SIMD, affine and fused matrix functions against the scalar implementation.
+ *
+ * Build (Linux):
+ *
+ *   g++ -O2 -std=c++11 -DHEADLESS -Isrc bench/matrix.cpp src/mathutils.cpp -o matrix-bench
+ */
+
+#include "mathutils.h"
+
+#include <stdlib.h>
+
+#define ITERATIONS 10000000
+
+static volatile GLfloat sink;
+
+/**
+ * Create a random 2D node matrix.
+ */
+static void make_random_matrix(GLfloat *m, bool affine) {
+    GLfloat r = rand() % 360;
+
+    make_node_matrix(rand() % 100, rand() % 100, affine ? 0:rand() % 100, 1.5f, 0.5f, affine ? 0:r, affine ? 0:r / 2, r, 10, 20, m);
+}
+
+/**
+ * Compare two matrices.
+ */
+static bool equal_matrix(const GLfloat *a, const GLfloat *b) {
+    for (int i = 0; i < 16; i++) {
+        if (fabsf(a[i] - b[i]) > 0.0001f * (1 + fabsf(a[i]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Old node matrix calculation (multiplied axis rotations).
+ */
+static void make_node_matrix_multiplied(GLfloat x, GLfloat y, GLfloat z, GLfloat sx, GLfloat sy, GLfloat rx, GLfloat ry, GLfloat rz, GLfloat ox, GLfloat oy, GLfloat *m) {
+    GLfloat rot[16];
+
+    make_x_rot_matrix(rx, m);
+    make_y_rot_matrix(ry, rot);
+    mul_matrix_scalar(m, m, rot);
+    make_z_rot_matrix(rz, rot);
+    mul_matrix_scalar(m, m, rot);
+
+    for (int col = 0; col < 3; col++) {
+        m[col * 4]     *= sx;
+        m[col * 4 + 1] *= sy;
+    }
+
+    m[12] = ox + x - (m[0] * ox + m[4] * oy);
+    m[13] = oy + y - (m[1] * ox + m[5] * oy);
+    m[14] = z - (m[2] * ox + m[6] * oy);
+}
+
+/**
+ * Time a multiplication function (nanoseconds per call).
+ */
+static double time_mul(void (*func)(GLfloat *, const GLfloat *, const GLfloat *), const GLfloat *a, const GLfloat *b) {
+    GLfloat p[16];
+    double start = getTime();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        func(p, a, b);
+        sink = p[i & 15];
+    }
+
+    return (getTime() - start) * 1e6 / ITERATIONS;
+}
+
+int main(int argc, char **argv) {
+    GLfloat a[16], b[16], p1[16], p2[16];
+    bool ok = true;
+
+    //verify
+    for (int i = 0; i < 1000; i++) {
+        make_random_matrix(a, false);
+        make_random_matrix(b, false);
+
+        mul_matrix_scalar(p1, a, b);
+        mul_matrix(p2, a, b);
+        ok &= equal_matrix(p1, p2);
+
+        make_random_matrix(a, true);
+        make_random_matrix(b, true);
+
+        mul_matrix_scalar(p1, a, b);
+        mul_matrix_affine(p2, a, b);
+        ok &= equal_matrix(p1, p2);
+
+        GLfloat rx = rand() % 360, ry = rand() % 360, rz = rand() % 360;
+
+        make_node_matrix_multiplied(1, 2, 3, 2, 3, rx, ry, rz, 4, 5, p1);
+        make_node_matrix(1, 2, 3, 2, 3, rx, ry, rz, 4, 5, p2);
+        ok &= equal_matrix(p1, p2);
+    }
+
+    if (!ok) {
+        printf("ERROR: results differ\n");
+        return 1;
+    }
+
+    //multiplication
+    make_random_matrix(a, true);
+    make_random_matrix(b, true);
+
+    printf("mul_matrix_scalar: %.2f ns\n", time_mul(mul_matrix_scalar, a, b));
+    printf("mul_matrix:        %.2f ns\n", time_mul(mul_matrix, a, b));
+    printf("mul_matrix_affine: %.2f ns\n", time_mul(mul_matrix_affine, a, b));
+
+    //node matrix (3D rotation)
+    double start = getTime();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        make_node_matrix_multiplied(1, 2, 3, 2, 3, i & 255, 45, 30, 4, 5, p1);
+        sink = p1[i & 15];
+    }
+
+    printf("node matrix (multiplied): %.2f ns\n", (getTime() - start) * 1e6 / ITERATIONS);
+
+    start = getTime();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        make_node_matrix(1, 2, 3, 2, 3, i & 255, 45, 30, 4, 5, p1);
+        sink = p1[i & 15];
+    }
+
+    printf("node matrix (fused):      %.2f ns\n", (getTime() - start) * 1e6 / ITERATIONS);
+
+    return 0;
+}
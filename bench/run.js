@@ -0,0 +1,36 @@
+'use strict';
+
+/**
+ * Run the native microbenchmarks and print the results as JSON.
+ *
+ * Build (headless Linux):
+ *
+ *   node-gyp rebuild --build_bench=1 --module_name=aminonative --module_path=build/binding
+ *
+ * Usage:
+ *
+ *   node bench/run.js [iterations] [video file]
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const bench = require('../build/Release/aminobench.node');
+const root = path.join(__dirname, '..');
+
+const options = {
+    iterations: parseInt(process.argv[2], 10) || 100000,
+    font: path.join(root, 'resources/SourceSansPro-Regular.ttf'),
+    images: {
+        png: fs.readFileSync(path.join(root, 'demos/images/tree.png')),
+        jpeg: fs.readFileSync(path.join(root, 'demos/images/yose.jpg'))
+    }
+};
+
+if (process.argv[3]) {
+    options.video = process.argv[3];
+}
+
+const results = bench.run(options);
+
+console.log(JSON.stringify(results, null, 2));
@@ -1,31 +1,39 @@
 {
-    "targets": [
-        {
-            "target_name": "aminonative",
-            "sources":[
-                "src/base.cpp",
-                "src/base_js.cpp",
-                "src/base_weak.cpp",
+    "variables": {
+        # build benchmarks: node-gyp rebuild --build_bench=1 --module_name=aminonative --module_path=build/binding
+        "build_bench%": 0,
+
+        "amino_sources": [
+            "src/base.cpp",
+            "src/base_js.cpp",
+            "src/base_weak.cpp",
 
-                "src/fonts/vector.c",
-                "src/fonts/vertex-buffer.c",
-                "src/fonts/vertex-attribute.c",
-                "src/fonts/texture-atlas.c",
-                "src/fonts/texture-font.c",
-                "src/fonts/utf8-utils.c",
-                "src/fonts/distance-field.c",
-                "src/fonts/edtaa3func.c",
-                "src/fonts/shader.c",
-                "src/fonts/mat4.c",
-                "src/fonts.cpp",
+            "src/fonts/vector.c",
+            "src/fonts/vertex-buffer.c",
+            "src/fonts/vertex-attribute.c",
+            "src/fonts/texture-atlas.c",
+            "src/fonts/texture-font.c",
+            "src/fonts/utf8-utils.c",
+            "src/fonts/distance-field.c",
+            "src/fonts/edtaa3func.c",
+            "src/fonts/shader.c",
+            "src/fonts/mat4.c",
+            "src/fonts.cpp",
 
-                "src/images.cpp",
+            "src/images.cpp",
 
-                "src/videos.cpp",
+            "src/videos.cpp",
 
-                "src/shaders.cpp",
-                "src/renderer.cpp",
-                "src/mathutils.cpp"
+            "src/shaders.cpp",
+            "src/renderer.cpp",
+            "src/mathutils.cpp"
+        ]
+    },
+    "targets": [
+        {
+            "target_name": "aminonative",
+            "sources": [
+                "<@(amino_sources)"
             ],
             "include_dirs": [
                 "<!(node -e \"require('nan')\")",
@@ -133,19 +141,24 @@
                             ]
 		                }],
 
+		                # headless (offscreen EGL)
 		                ["target_arch!='arm'", {
 		                    "sources": [
-		                        "src/mac.cpp"
+		                        "src/headless.cpp"
 		                    ],
 		                    "libraries":[
+		                        "-lGLESv2",
+		                        "-lEGL",
 		                        '<!@(freetype-config --libs)',
-		                        "-lglfw",
                                 "-ljpeg",
-                                "-lpng"
+                                "-lpng",
+                                '-lavcodec',
+                                '-lavformat',
+                                '-lswscale'
 		                    ],
 		                    "defines": [
 		                        "GL_GLEXT_PROTOTYPES",
-		                        "LINUX"
+		                        "HEADLESS"
 		                    ],
 		                    "include_dirs": [
 		                        "/usr/include/freetype2",
@@ -165,5 +178,51 @@
                 "destination": "<(module_path)"
             }]
         }
+    ],
+    "conditions": [
+        # benchmarks (headless Linux only)
+        ['OS=="linux" and target_arch!="arm" and build_bench==1', {
+            "targets": [
+                {
+                    "target_name": "aminobench",
+                    "sources": [
+                        "<@(amino_sources)",
+                        "src/headless.cpp",
+                        "bench/bench.cpp"
+                    ],
+                    "include_dirs": [
+                        "<!(node -e \"require('nan')\")",
+                        "src/",
+                        "src/fonts/",
+                        "src/images/",
+                        "bench/",
+                        "/usr/include/freetype2",
+                        "<!@(freetype-config --cflags)"
+                    ],
+                    "cflags": [
+                        "-Wall",
+                        "-O2"
+                    ],
+                    "cxxflags": [
+                        "-std=c++11"
+                    ],
+                    "libraries":[
+                        "-lGLESv2",
+                        "-lEGL",
+                        '<!@(freetype-config --libs)',
+                        "-ljpeg",
+                        "-lpng",
+                        '-lavcodec',
+                        '-lavformat',
+                        '-lswscale'
+                    ],
+                    "defines": [
+                        "GL_GLEXT_PROTOTYPES",
+                        "HEADLESS",
+                        "AMINO_BENCH"
+                    ]
+                }
+            ]
+        }]
     ]
 }
@@ -0,0 +1,51 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //texts
+    const root = this.getRoot();
+    const texts = [];
+
+    for (let i = 0; i < 8; i++) {
+        const text = this.createText().x(10).y(40 + i * 50).fontSize(40).fill('#FFFFFF');
+
+        root.add(text);
+        texts.push(text);
+    }
+
+    //cycle through large font sizes and character ranges (fills atlas pages)
+    let start = 0x20;
+    let size = 40;
+
+    setInterval(() => {
+        for (const text of texts) {
+            let str = '';
+
+            for (let j = 0; j < 20; j++) {
+                str += String.fromCharCode(start++);
+            }
+
+            if (start > 0x24F) {
+                start = 0x20;
+                size = size >= 120 ? 40 : size + 20;
+            }
+
+            text.fontSize(size).text(str);
+        }
+    }, 200);
+
+    //stats: atlasPages, atlasMemory, atlasUsage, atlasEvictions
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
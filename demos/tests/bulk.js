@@ -0,0 +1,51 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    const root = this.createGroup();
+    const count = 2000;
+    const nodes = [];
+
+    for (let i = 0; i < count; i++) {
+        const r = this.createRect().w(4).h(4).fill('#00FF00');
+
+        root.add(r);
+        nodes.push(r);
+    }
+
+    this.setRoot(root);
+
+    //move all nodes with two native calls per frame
+    const w = this.w();
+    const h = this.h();
+    const xs = new Float32Array(count);
+    const ys = new Float32Array(count);
+    let t = 0;
+
+    setInterval(() => {
+        for (let i = 0; i < count; i++) {
+            const a = i / count * Math.PI * 2 + t;
+
+            xs[i] = w / 2 + Math.cos(a * 3) * w / 3;
+            ys[i] = h / 2 + Math.sin(a * 2) * h / 3;
+        }
+
+        this.setProperties(nodes, 'x', xs);
+        this.setProperties(nodes, 'y', ys);
+
+        t += 0.01;
+    }, 16);
+
+    //stats
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
@@ -0,0 +1,47 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx({
+    //layer memory (MB)
+    layerBudget: 16
+});
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //static content (rendered once to a texture)
+    const root = this.getRoot();
+    const panel = this.createGroup().w(400).h(400).cache(true);
+
+    for (let y = 0; y < 40; y++) {
+        for (let x = 0; x < 40; x++) {
+            const r = this.createRect().x(x * 10).y(y * 10).w(8).h(8);
+
+            r.fill((x + y) % 2 ? '#FF0000' : '#0000FF');
+            panel.add(r);
+        }
+    }
+
+    root.add(panel);
+
+    //moving the layer does not render the children again
+    panel.x.anim().from(0).to(200).dur(2000).loop(-1).autoreverse(true).start();
+
+    //changing a child renders the layer again
+    setInterval(() => {
+        const child = panel.children[Math.floor(Math.random() * panel.children.length)];
+
+        child.fill('#FFFFFF');
+    }, 2000);
+
+    //stats: layers, layerMemory, layersRendered
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
@@ -0,0 +1,42 @@
+'use strict';
+
+const amino = require('../../main.js');
+const fs = require('fs');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#0000FF');
+
+    //scene
+    const r = this.createRect().x(50).y(50).w(100).h(100);
+
+    r.fill('#FFFFFF');
+    this.getRoot().add(r);
+
+    //single frame
+    this.captureFrame((err, frame) => {
+        console.log('frame: ' + frame.w + 'x' + frame.h + ' (' + frame.buffer.length + ' bytes)');
+
+        //raw RGBA data
+        fs.writeFileSync('capture.rgba', frame.buffer);
+    });
+
+    //stream (5 fps)
+    let count = 0;
+
+    this.startCapture({ fps: 5 }, (err, frame) => {
+        count++;
+        console.log('stream frame ' + count + ': time=' + frame.time.toFixed(0));
+
+        if (count === 10) {
+            this.stopCapture();
+            console.log('stats: ' + JSON.stringify(this.getStats()));
+        }
+    });
+});
@@ -0,0 +1,44 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //static grid
+    const root = this.getRoot();
+    const grid = this.createGroup();
+
+    for (let y = 0; y < 20; y++) {
+        for (let x = 0; x < 20; x++) {
+            const r = this.createRect().x(x * 20).y(y * 20).w(18).h(18);
+
+            r.fill('#00FF00');
+            grid.add(r);
+        }
+    }
+
+    root.add(grid);
+
+    //single animated node (only its subtree is recorded again)
+    const r = this.createRect().x(0).y(420).w(50).h(50);
+
+    r.fill('#FFFFFF');
+    root.add(r);
+
+    setTimeout(() => {
+        r.x.anim().from(0).to(400).dur(2000).loop(-1).autoreverse(true).start();
+    }, 3000);
+
+    //stats: commands, recordedNodes, commandRebuilds
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
@@ -0,0 +1,37 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //clipped list (most items off-screen)
+    const root = this.getRoot();
+    const clip = this.createGroup().x(100).y(100).w(200).h(300).clipRect(true);
+    const list = this.createGroup();
+
+    for (let i = 0; i < 1000; i++) {
+        const r = this.createRect().x(0).y(i * 30).w(200).h(28);
+
+        r.fill(i % 2 ? '#FF0000' : '#00FF00');
+        list.add(r);
+    }
+
+    clip.add(list);
+    root.add(clip);
+
+    //scroll
+    list.y.anim().from(0).to(-30000 + 300).dur(20000).loop(-1).start();
+
+    //stats: culledNodes
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
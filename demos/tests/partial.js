@@ -0,0 +1,41 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx({
+    //redraw changed areas only
+    partialRedraw: true
+});
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //static content
+    const root = this.getRoot();
+
+    for (let i = 0; i < 10; i++) {
+        const r = this.createRect().x(i * 40).y(100).w(30).h(200);
+
+        r.fill('#0000FF');
+        root.add(r);
+    }
+
+    //clock (only changing area)
+    const clock = this.createText().x(10).y(40).fontSize(30).fill('#FFFFFF');
+
+    root.add(clock);
+
+    setInterval(() => {
+        clock.text(new Date().toLocaleTimeString());
+    }, 1000);
+
+    //stats: skippedFrames, damageRatio
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
@@ -0,0 +1,55 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    //large polyline
+    const count = 50000;
+    const w = this.w();
+    const h = this.h();
+    const points = new Float32Array(count * 2);
+
+    for (let i = 0; i < count; i++) {
+        points[i * 2] = i * w / count;
+        points[i * 2 + 1] = h / 2;
+    }
+
+    const poly = this.createPolygon().filled(false).fill('#00FF00');
+
+    poly.geometry(points);
+    this.setRoot(poly);
+
+    //update a small window each frame
+    const chunk = 500;
+    const values = new Float32Array(chunk * 2);
+    let pos = 0;
+    let phase = 0;
+
+    setInterval(() => {
+        for (let i = 0; i < chunk; i++) {
+            values[i * 2] = (pos + i) * w / count;
+            values[i * 2 + 1] = h / 2 + Math.sin((pos + i) / 50 + phase) * h / 3;
+        }
+
+        poly.setGeometryRange(pos * 2, values);
+
+        pos += chunk;
+
+        if (pos >= count) {
+            pos = 0;
+            phase += 0.5;
+        }
+    }, 16);
+
+    //stats: uploadBytes
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
@@ -0,0 +1,50 @@
+'use strict';
+
+const path = require('path');
+const amino = require('../../main.js');
+
+//same glyphs as default font (distance field)
+amino.fonts.registerFont({
+    name: 'source-sdf',
+    path: path.join(__dirname, '../../resources/'),
+    sdf: true,
+    weights: {
+        400: {
+            normal: 'SourceSansPro-Regular.ttf'
+        }
+    }
+});
+
+const gfx = new amino.AminoGfx();
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    const root = this.getRoot();
+
+    //zooming text (no re-rasterization)
+    const text = this.createText().x(20).y(200).fontName('source-sdf').fontSize(20).text('Distance Field').fill('#FFFFFF');
+
+    root.add(text);
+
+    text.sx.anim().from(1).to(4).dur(3000).autoreverse(true).loop(-1).start();
+    text.sy.anim().from(1).to(4).dur(3000).autoreverse(true).loop(-1).start();
+
+    //font sizes (same atlas)
+    for (let i = 0; i < 6; i++) {
+        const size = 10 + i * 12;
+        const sample = this.createText().x(20).y(300 + i * 60).fontName('source-sdf').fontSize(size).text('Size ' + size).fill('#FFFF00');
+
+        root.add(sample);
+    }
+
+    //stats: atlasPages, atlasMemory, atlasUsage
+    setInterval(() => {
+        console.log('stats: ' + JSON.stringify(this.getStats()));
+    }, 1000);
+});
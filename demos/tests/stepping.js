@@ -0,0 +1,50 @@
+'use strict';
+
+const amino = require('../../main.js');
+
+//create instance (manual clock)
+const gfx = new amino.AminoGfx({
+    stepping: true
+});
+
+gfx.start(function (err) {
+    if (err) {
+        console.log('Amino error: ' + err.message);
+        return;
+    }
+
+    this.fill('#000000');
+
+    //create group
+    const g = this.createGroup();
+
+    this.setRoot(g);
+
+    //animation
+    const r = this.createRect().x(0).y(0).w(100).h(100);
+
+    r.fill('#FFFFFF');
+    r.x.anim().from(0).to(500).dur(1000).loop(1).start();
+
+    g.add(r);
+
+    //render 60 frames at 60 fps
+    let frames = 60;
+
+    const next = () => {
+        this.step(1000 / 60, (err, info) => {
+            console.log('frame ' + info.frame + ': time=' + info.time.toFixed(2) + ' ms, render=' + info.renderTime.toFixed(2) + ' ms, x=' + r.x());
+
+            frames--;
+
+            if (frames > 0) {
+                next();
+            } else {
+                console.log('stats: ' + JSON.stringify(this.getStats()));
+                this.destroy();
+            }
+        });
+    };
+
+    next();
+});
@@ -283,6 +283,45 @@ function setSize(w, h) {
     this.w(w).h(h);
 };
 
+/**
+ * Render the next frame and advance the animation clock by dt milliseconds.
+ *
+ * Note: needs the stepping option (e.g. new AminoGfx({ stepping: true })).
+ */
+AminoGfx.prototype.step = function (dt, done) {
+    this._step(dt, done);
+};
+
+/**
+ * Capture the next rendered frame.
+ *
+ * The callback gets an object with w, h, bpp, time and buffer (RGBA, top-down).
+ */
+AminoGfx.prototype.captureFrame = function (done) {
+    this._captureFrame(done);
+};
+
+/**
+ * Capture frames continuously.
+ *
+ * Options: fps (frame rate cap; 0 or missing captures every frame).
+ */
+AminoGfx.prototype.startCapture = function (opts, done) {
+    if (typeof opts === 'function') {
+        done = opts;
+        opts = {};
+    }
+
+    this._startCapture(opts.fps || 0, done);
+};
+
+/**
+ * Stop continuous frame capture.
+ */
+AminoGfx.prototype.stopCapture = function () {
+    this._stopCapture();
+};
+
 /**
  * Get runtime system info.
  */
@@ -296,6 +335,38 @@ AminoGfx.prototype.getStats = function () {
     return stats;
 };
 
+/**
+ * Set a numeric property of many nodes in a single native call.
+ *
+ * Note: the JS values are updated without firing property listeners.
+ *
+ * @param nodes array of nodes.
+ * @param name property name (e.g. 'x').
+ * @param values Float32Array or array with one value per node.
+ */
+AminoGfx.prototype.setProperties = function (nodes, name, values) {
+    const count = nodes.length;
+
+    if (count === 0) {
+        return this;
+    }
+
+    const first = nodes[0][name];
+
+    if (!first || !first.propId) {
+        throw new Error('unknown property: ' + name);
+    }
+
+    this._setProperties(nodes, first.propId, values);
+
+    //sync JS values
+    for (let i = 0; i < count; i++) {
+        nodes[i][name].value = values[i];
+    }
+
+    return this;
+};
+
 /**
  * Find node with id.
  */
@@ -546,7 +617,10 @@ Group.prototype.init = function () {
         clipRect: false,
 
         //3D rendering (depth test)
-        depth: false
+        depth: false,
+
+        //render to texture (static content)
+        cache: false
     });
 
     this.isGroup = true;
@@ -1421,6 +1495,39 @@ function setFill(val, prop, obj) {
     obj.fillB(color.b);
 }
 
+/**
+ * Update part of the geometry.
+ *
+ * Only the modified values are passed to the renderer and uploaded.
+ */
+Polygon.prototype.setGeometryRange = function (offset, data) {
+    const geometry = this.geometry();
+    const end = offset + data.length;
+
+    if (!geometry || end > geometry.length) {
+        //grows: set new geometry
+        const values = new Float32Array(end);
+
+        if (geometry) {
+            values.set(geometry);
+        }
+
+        values.set(data, offset);
+        this.geometry(values);
+
+        return this;
+    }
+
+    //update cached value
+    for (let i = 0; i < data.length; i++) {
+        geometry[offset + i] = data[i];
+    }
+
+    this._setGeometryRange(offset, data);
+
+    return this;
+};
+
 /**
  * Check if point inside of polygon.
  */
@@ -1784,6 +1891,8 @@ AminoFonts.prototype.init = function () {
 
 /**
  * Register a font.
+ *
+ * Set sdf to true to render all sizes from one distance field glyph set.
  */
 AminoFonts.prototype.registerFont = function (font) {
     //check existing font (immutable)
@@ -1919,7 +2028,10 @@ AminoFonts.prototype.getFont = function (descr, callback) {
 
                 name: name,
                 weight: weight,
-                style: style
+                style: style,
+
+                //signed distance field glyphs (shared by all sizes)
+                sdf: !!font.sdf
             });
 
             resolve(font);
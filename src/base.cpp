@@ -2,6 +2,8 @@
 
 #include <cwctype>
 #include <algorithm>
+#include <string.h>
+#include <unistd.h>
 
 #include "renderer.h"
 #include "fonts/utf8-utils.h"
@@ -12,6 +14,77 @@
 
 #define MEASURE_FPS true
 #define SHOW_RENDERER_ERRORS true
+#define DEBUG_CAPTURE false
+
+/**
+ * Convert captured pixels (flip vertically) in worker thread.
+ */
+class AsyncFrameWorker : public Nan::AsyncWorker {
+private:
+    amino_capture_t *capture;
+
+    //result
+    char *data = NULL;
+
+public:
+    AsyncFrameWorker(amino_capture_t *capture) : AsyncWorker(NULL), capture(capture) {
+        //empty
+    }
+
+    /**
+     * Async running code.
+     */
+    void Execute() {
+        //OpenGL rows are bottom-up
+        size_t rowSize = capture->w * 4;
+
+        data = (char *)malloc(capture->size); //gets transferred to buffer
+
+        assert(data);
+
+        for (int y = 0; y < capture->h; y++) {
+            memcpy(data + y * rowSize, capture->pixels + (capture->h - y - 1) * rowSize, rowSize);
+        }
+    }
+
+    /**
+     * Back in main thread with JS access.
+     */
+    void HandleOKCallback() {
+        //transfer ownership
+        v8::Local<v8::Object> buff = Nan::NewBuffer(data, capture->size).ToLocalChecked();
+
+        capture->gfx->frameCaptured(capture, buff);
+    }
+};
+
+/**
+ * Layout text in worker thread.
+ */
+class AsyncTextLayoutWorker : public Nan::AsyncWorker {
+private:
+    AminoText *text;
+    text_layout_t *layout;
+
+public:
+    AsyncTextLayoutWorker(AminoText *text, text_layout_t *layout) : AsyncWorker(NULL), text(text), layout(layout) {
+        //empty
+    }
+
+    /**
+     * Async running code.
+     */
+    void Execute() {
+        AminoText::layoutText(layout);
+    }
+
+    /**
+     * Back in main thread.
+     */
+    void HandleOKCallback() {
+        text->layoutDone(layout);
+    }
+};
 
 //
 //  AminoGfx
@@ -31,6 +104,37 @@ AminoGfx::AminoGfx(std::string name): AminoJSEventObject(name) {
     // animLock
     res = pthread_mutex_init(&animLock, &attr);
     assert(res == 0);
+
+    //frame stepping
+    res = uv_mutex_init(&stepLock);
+    assert(res == 0);
+
+    res = uv_cond_init(&stepCond);
+    assert(res == 0);
+
+    //idle
+    res = uv_mutex_init(&idleLock);
+    assert(res == 0);
+
+    res = uv_cond_init(&idleCond);
+    assert(res == 0);
+
+    //frame capture
+    res = uv_mutex_init(&captureLock);
+    assert(res == 0);
+
+    for (int i = 0; i < 2; i++) {
+        amino_capture_t *capture = &captures[i];
+
+        capture->gfx = this;
+        capture->busy = false;
+        capture->pixels = NULL;
+        capture->size = 0;
+        capture->w = 0;
+        capture->h = 0;
+        capture->time = 0;
+        capture->stream = false;
+    }
 }
 
 AminoGfx::~AminoGfx() {
@@ -50,6 +154,29 @@ AminoGfx::~AminoGfx() {
 
     assert(res == 0);
 
+    uv_mutex_destroy(&stepLock);
+    uv_cond_destroy(&stepCond);
+
+    uv_mutex_destroy(&idleLock);
+    uv_cond_destroy(&idleCond);
+
+    //capture buffers
+    for (int i = 0; i < 2; i++) {
+        if (captures[i].pixels) {
+            free(captures[i].pixels);
+            captures[i].pixels = NULL;
+        }
+    }
+
+    uv_mutex_destroy(&captureLock);
+
+    //node storage (all nodes released)
+    for (std::size_t i = 0; i < nodeChunks.size(); i++) {
+        delete nodeChunks[i];
+    }
+
+    nodeChunks.clear();
+
     //Note: properties are deleted by base class destructor
 }
 
@@ -117,11 +244,22 @@ void AminoGfx::Init(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target, AminoJSObject
     Nan::SetTemplate(tpl, "Texture", AminoTexture::GetInitFunction());
     Nan::SetTemplate(tpl, "Anim", AminoAnim::GetInitFunction());
 
+    // bulk updates
+    Nan::SetPrototypeMethod(tpl, "_setProperties", SetProperties);
+
     // animations
     Nan::SetPrototypeMethod(tpl, "clearAnimations", ClearAnimations);
-    Nan::SetPrototypeMethod(tpl, "getTime", GetTime);
+    Nan::SetPrototypeMethod(tpl, "getTime", GetClockTime);
     Nan::SetMethod(tpl, "getTime", GetTime);
 
+    // frame stepping
+    Nan::SetPrototypeMethod(tpl, "_step", Step);
+
+    // frame capture
+    Nan::SetPrototypeMethod(tpl, "_captureFrame", CaptureFrame);
+    Nan::SetPrototypeMethod(tpl, "_startCapture", StartCapture);
+    Nan::SetPrototypeMethod(tpl, "_stopCapture", StopCapture);
+
     //settings
     Nan::SetPrototypeMethod(tpl, "updatePerspective", UpdatePerspective);
 
@@ -264,6 +402,28 @@ void AminoGfx::initRenderer() {
                 swapInterval = swapIntervalValue->Int32Value();
             }
         }
+
+        //frame stepping (manual clock)
+        Nan::MaybeLocal<v8::Value> steppingMaybe = Nan::Get(obj, Nan::New<v8::String>("stepping").ToLocalChecked());
+
+        if (!steppingMaybe.IsEmpty()) {
+            v8::Local<v8::Value> steppingValue = steppingMaybe.ToLocalChecked();
+
+            if (steppingValue->IsBoolean()) {
+                stepping = steppingValue->BooleanValue();
+            }
+        }
+
+        //partial redraw (damaged areas only)
+        Nan::MaybeLocal<v8::Value> partialRedrawMaybe = Nan::Get(obj, Nan::New<v8::String>("partialRedraw").ToLocalChecked());
+
+        if (!partialRedrawMaybe.IsEmpty()) {
+            v8::Local<v8::Value> partialRedrawValue = partialRedrawMaybe.ToLocalChecked();
+
+            if (partialRedrawValue->IsBoolean()) {
+                partialRedraw = partialRedrawValue->BooleanValue();
+            }
+        }
     }
 }
 
@@ -279,6 +439,7 @@ void AminoGfx::setupRenderer() {
 
     renderer = new AminoRenderer(this);
     renderer->setup();
+    renderer->setPartialRedraw(partialRedraw);
 
     if (!createParams.IsEmpty()) {
         v8::Local<v8::Object> obj = Nan::New(createParams);
@@ -295,6 +456,17 @@ void AminoGfx::setupRenderer() {
                 renderer->setupPerspective(perspective);
             }
         }
+
+        //layer cache budget (MB)
+        Nan::MaybeLocal<v8::Value> layerBudgetMaybe = Nan::Get(obj, Nan::New<v8::String>("layerBudget").ToLocalChecked());
+
+        if (!layerBudgetMaybe.IsEmpty()) {
+            v8::Local<v8::Value> layerBudgetValue = layerBudgetMaybe.ToLocalChecked();
+
+            if (layerBudgetValue->IsNumber()) {
+                renderer->setLayerBudget(layerBudgetValue->NumberValue() * 1024 * 1024);
+            }
+        }
     }
 }
 
@@ -393,6 +565,17 @@ void AminoGfx::renderingThread(void *arg) {
 
     //rendering loop
     while (gfx->isRenderingThreadRunning()) {
+        //wait for next step (manual clock)
+        amino_step_t *step = NULL;
+
+        if (gfx->stepping) {
+            step = gfx->waitForStep();
+
+            if (!step) {
+                break;
+            }
+        }
+
         if (DEBUG_THREADS) {
             uv_thread_t threadId = uv_thread_self();
 
@@ -403,12 +586,19 @@ void AminoGfx::renderingThread(void *arg) {
             gfx->measureRenderingStart();
         }
 
+        double renderStart = getTime();
+
         gfx->render();
 
         if (MEASURE_FPS) {
             gfx->measureRenderingEnd();
         }
 
+        if (step) {
+            step->renderTime = getTime() - renderStart;
+            gfx->stepDone(step);
+        }
+
         //check errors
         if (DEBUG_RENDERER || SHOW_RENDERER_ERRORS) {
             int errors = AminoRenderer::showGLErrors();
@@ -419,6 +609,11 @@ void AminoGfx::renderingThread(void *arg) {
         if (DEBUG_THREADS) {
             printf("rendering: cycle done\n");
         }
+
+        //wait for changes
+        if (!step) {
+            gfx->waitForChanges();
+        }
     }
 
     //renderer done
@@ -502,6 +697,11 @@ void AminoGfx::startRenderingThread() {
     asyncHandle.data = this;
     uv_async_init(uv_default_loop(), &asyncHandle, AminoGfx::handleRenderEvents);
 
+    //poll system events (rendering thread blocks while idle)
+    eventTimer.data = this;
+    uv_timer_init(uv_default_loop(), &eventTimer);
+    uv_timer_start(&eventTimer, AminoGfx::handleEventTimer, EVENT_POLL_INTERVAL, EVENT_POLL_INTERVAL);
+
     //retain instance (while thread is running)
     retain();
 }
@@ -536,6 +736,20 @@ void AminoGfx::handleRenderEvents(uv_async_t *handle) {
     }
 }
 
+/**
+ * Poll system events (independent of rendering).
+ */
+void AminoGfx::handleEventTimer(uv_timer_t *handle) {
+    AminoGfx *gfx = static_cast<AminoGfx *>(handle->data);
+
+    assert(gfx);
+
+    //create scope
+    Nan::HandleScope scope;
+
+    gfx->handleSystemEvents();
+}
+
 /**
  * Stop rendering thread.
  *
@@ -546,20 +760,33 @@ void AminoGfx::stopRenderingThread() {
         return;
     }
 
+    //wake up rendering thread (waiting for next step)
+    uv_mutex_lock(&stepLock);
     threadRunning = false;
+    uv_cond_signal(&stepCond);
+    uv_mutex_unlock(&stepLock);
+
+    //wake up rendering thread (idle)
+    wakeUp();
 
     int res = uv_thread_join(&thread);
 
     assert(res == 0);
 
+    //free pending steps
+    clearSteps();
+
     //process remaining events
     res = uv_async_send(&asyncHandle);
 
     assert(res == 0);
 
-    //destroy handle
+    //destroy handles
     uv_close((uv_handle_t *)&asyncHandle, NULL);
 
+    uv_timer_stop(&eventTimer);
+    uv_close((uv_handle_t *)&eventTimer, NULL);
+
     //release instance
     release();
 }
@@ -614,7 +841,20 @@ void AminoGfx::render() {
         printf("-> renderer: renderScene()\n");
     }
 
-    renderScene();
+    if (!renderScene()) {
+        //nothing changed: keep the displayed frame
+        fpsCycleEnd = getTime();
+        rendering = false;
+
+        if (!stepping) {
+            usleep(IDLE_FRAME_TIME);
+        }
+
+        return;
+    }
+
+    //read back pixels
+    captureScene();
 
     //done
     fpsCycleEnd = getTime();
@@ -652,7 +892,7 @@ void AminoGfx::processAnimations() {
 
     assert(res == 0);
 
-    double currentTime = getTime();
+    double currentTime = getClockTime();
     int count = animations.size();
 
     //debug timer
@@ -667,175 +907,860 @@ void AminoGfx::processAnimations() {
 }
 
 /**
- * Clear all animations.
+ * Check if the next frame would not change (no updates, animations, videos or captures).
  *
- * Note: stops gets not called.
+ * Note: called on rendering thread.
  */
-NAN_METHOD(AminoGfx::ClearAnimations) {
-    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+bool AminoGfx::isIdle() {
+    if (!threadRunning || destroyed) {
+        return false;
+    }
 
-    assert(obj);
+    //updates
+    if (hasAsyncUpdates() || !textUpdates.empty() || !atlasTextureUpdates.empty()) {
+        return false;
+    }
 
-    obj->clearAnimations();
-}
+    //animations
+    bool active = false;
+    int res = pthread_mutex_lock(&animLock);
 
-/**
- * Get current timer time (monotonic time, not current system time!).
- */
-NAN_METHOD(AminoGfx::GetTime) {
-    info.GetReturnValue().Set(getTime());
-}
+    assert(res == 0);
 
-/**
- * Check if rendering scene right now.
- */
-bool AminoGfx::isRendering() {
-    return rendering;
-}
+    std::size_t count = animations.size();
 
-/**
- * Render the root node and all its children.
- */
-void AminoGfx::renderScene() {
-    if (!root) {
-        return;
+    for (std::size_t i = 0; i < count; i++) {
+        if (animations[i]->isActive()) {
+            active = true;
+            break;
+        }
     }
 
-    if (viewportChanged) {
-        viewportChanged = false;
+    res = pthread_mutex_unlock(&animLock);
+    assert(res == 0);
 
-        renderer->updateViewport(propW->value, propH->value, viewportW, viewportH);
+    if (active) {
+        return false;
     }
 
-    renderer->initScene(propR->value, propG->value, propB->value, propOpacity->value);
-    renderer->renderScene(root);
+    //frame capture
+    if (isCapturePending()) {
+        return false;
+    }
+
+    //visible videos
+    if (renderer && renderer->hasPlayingVideos()) {
+        return false;
+    }
+
+    return true;
 }
 
 /**
- * Stop rendering and free resources.
+ * Block the rendering thread until the scene changes.
+ *
+ * Note: called on rendering thread.
  */
-NAN_METHOD(AminoGfx::Destroy) {
-    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+void AminoGfx::waitForChanges() {
+    bool idle = isIdle();
 
-    assert(obj);
+    uv_mutex_lock(&idleLock);
 
-    if (!obj->destroyed) {
-        obj->destroy();
+    if (idle && !idleWakeUp) {
+        if (DEBUG_THREADS) {
+            printf("rendering: idle\n");
+        }
+
+        double start = getTime();
+
+        while (!idleWakeUp) {
+            uv_cond_wait(&idleCond, &idleLock);
+        }
+
+        idleTime += getTime() - start;
     }
+
+    //changes after this point are handled by the next cycle
+    idleWakeUp = false;
+
+    uv_mutex_unlock(&idleLock);
 }
 
 /**
- * Stop rendering and free resources.
+ * Continue rendering (scene changes).
  *
- * Note: has to run on main thread.
+ * Note: called on any thread.
  */
-void AminoGfx::destroy() {
-    if (destroyed) {
-        return;
-    }
-
-    //instance
-    destroyAminoGfx();
-
-    //base destroy
-    AminoJSEventObject::destroy();
+void AminoGfx::wakeUp() {
+    uv_mutex_lock(&idleLock);
+    idleWakeUp = true;
+    uv_cond_signal(&idleCond);
+    uv_mutex_unlock(&idleLock);
 }
 
 /**
- * Stop rendering and free resources.
+ * Get a storage slot for the node values.
  *
- * Note: has to run on main thread.
+ * Note: has to be called on main thread.
  */
-void AminoGfx::destroyAminoGfx() {
-    //stop thread
-    stopRenderingThread();
-
-    //bind context (to main thread)
-    if (started) {
-        started = false;
-
-        bool res = bindContext();
+int AminoGfx::allocNodeSlot(amino_node_chunk_t *&chunk, int &index) {
+    int slot;
 
-        assert(res);
+    if (!freeNodeSlots.empty()) {
+        //reuse
+        slot = freeNodeSlots.back();
+        freeNodeSlots.pop_back();
+    } else {
+        //append
+        slot = nodeSlotCount++;
 
-        //renderer
-        if (renderer) {
-            delete renderer;
-            renderer = NULL;
+        if (slot / NODE_CHUNK_SIZE >= (int)nodeChunks.size()) {
+            nodeChunks.push_back(new amino_node_chunk_t());
         }
     }
 
-    //unbind root
-    setRoot(NULL);
-
-    //free async
-    clearAsyncQueue();
-    clearAnimations();
-    handleAsyncDeletes();
+    chunk = nodeChunks[slot / NODE_CHUNK_SIZE];
+    index = slot % NODE_CHUNK_SIZE;
 
-    //params
-    createParams.Reset();
+    //default values
+    chunk->x[index] = 0;
+    chunk->y[index] = 0;
+    chunk->z[index] = 0;
+    chunk->sx[index] = 0;
+    chunk->sy[index] = 0;
+    chunk->rx[index] = 0;
+    chunk->ry[index] = 0;
+    chunk->rz[index] = 0;
+    chunk->opacity[index] = 0;
+    chunk->visible[index] = false;
 
-    //debug
-    if (DEBUG_BASE) {
-        printf("AminoGfx destroyed -> %i references left\n", getReferenceCount());
-    }
+    return slot;
 }
 
 /**
- * Size has changed, update internal and JS properties.
+ * Return a storage slot.
  *
- * Note: has to be called after window size has changed. Does not touch the window size.
+ * Note: has to be called on main thread.
  */
-void AminoGfx::updateSize(int w, int h) {
-    propW->setValue(w);
-    propH->setValue(h);
+void AminoGfx::freeNodeSlot(int slot) {
+    assert(slot >= 0 && slot < nodeSlotCount);
+
+    freeNodeSlots.push_back(slot);
 }
 
 /**
- * Position has changed, update internal and JS properties.
- *
- * Note: has to be called after window position has changed. Does not touch the window position.
+ * Wake up the rendering thread on new updates.
  */
-void AminoGfx::updatePosition(int x, int y) {
-    propX->setValue(x);
-    propY->setValue(y);
+void AminoGfx::asyncUpdateAdded() {
+    wakeUp();
 }
 
 /**
- * Fire runtime specific event.
+ * Clear all animations.
  *
- * Note: has to be called on main thread!
+ * Note: stops gets not called.
  */
-void AminoGfx::fireEvent(v8::Local<v8::Object> &evt) {
-    //event handler
-    v8::Local<v8::Object> obj = handle();
-    Nan::MaybeLocal<v8::Value> handleEventMaybe = Nan::Get(obj, Nan::New<v8::String>("handleEvent").ToLocalChecked());
-
-    if (!handleEventMaybe.IsEmpty()) {
-        v8::Local<v8::Value> value = handleEventMaybe.ToLocalChecked();
+NAN_METHOD(AminoGfx::ClearAnimations) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
 
-        if (value->IsFunction()) {
-            v8::Local<v8::Function> func = value.As<v8::Function>();
+    assert(obj);
 
-            //call
-            int argc = 1;
-            v8::Local<v8::Value> argv[1] = { evt };
+    obj->clearAnimations();
+}
 
-            func->Call(obj, argc, argv);
-        }
-    }
+/**
+ * Get current timer time (monotonic time, not current system time!).
+ */
+NAN_METHOD(AminoGfx::GetTime) {
+    info.GetReturnValue().Set(getTime());
 }
 
 /**
- * Handle sync property updates.
+ * Get the animation clock time (virtual time in frame stepping mode).
  */
-bool AminoGfx::handleSyncUpdate(AnyProperty *property, void *data) {
-    //debug
-    //printf("handleSyncUpdate() %s\n", property->name.c_str());
+NAN_METHOD(AminoGfx::GetClockTime) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
 
-    //default: does nothing
-    bool res = AminoJSObject::handleSyncUpdate(property, data);
+    assert(obj);
+
+    info.GetReturnValue().Set(obj->getClockTime());
+}
+
+/**
+ * Check if frame stepping (manual clock) is enabled.
+ */
+bool AminoGfx::isStepping() {
+    return stepping;
+}
+
+/**
+ * Get the current animation time.
+ *
+ * Note: monotonic time unless frame stepping is enabled.
+ */
+double AminoGfx::getClockTime() {
+    if (!stepping) {
+        return getTime();
+    }
+
+    uv_mutex_lock(&stepLock);
+
+    double time = clockTime;
+
+    uv_mutex_unlock(&stepLock);
+
+    return time;
+}
+
+/**
+ * Render the next frame and advance the manual clock.
+ *
+ * Parameters: dt (milliseconds), optional callback
+ */
+NAN_METHOD(AminoGfx::Step) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    //validate state
+    if (!obj->stepping) {
+        Nan::ThrowTypeError("frame stepping not enabled");
+        return;
+    }
+
+    if (!obj->started) {
+        Nan::ThrowTypeError("not started");
+        return;
+    }
+
+    if (info.Length() < 1 || !info[0]->IsNumber()) {
+        Nan::ThrowTypeError("missing time delta");
+        return;
+    }
+
+    double dt = info[0]->NumberValue();
+
+    if (dt < 0) {
+        Nan::ThrowTypeError("negative time delta");
+        return;
+    }
+
+    //create step
+    amino_step_t *step = new amino_step_t();
+
+    step->dt = dt;
+    step->callback = NULL;
+
+    if (info.Length() >= 2 && info[1]->IsFunction()) {
+        step->callback = new Nan::Callback(info[1].As<v8::Function>());
+    }
+
+    //enqueue
+    uv_mutex_lock(&obj->stepLock);
+    obj->steps.push(step);
+    uv_cond_signal(&obj->stepCond);
+    uv_mutex_unlock(&obj->stepLock);
+}
+
+/**
+ * Wait for the next step and advance the clock.
+ *
+ * Note: called on rendering thread. Returns NULL if the rendering thread was stopped.
+ */
+amino_step_t* AminoGfx::waitForStep() {
+    uv_mutex_lock(&stepLock);
+
+    while (steps.empty() && threadRunning) {
+        uv_cond_wait(&stepCond, &stepLock);
+    }
+
+    if (!threadRunning) {
+        uv_mutex_unlock(&stepLock);
+
+        return NULL;
+    }
+
+    amino_step_t *step = steps.front();
+
+    steps.pop();
+
+    //advance clock
+    clockTime += step->dt;
+    stepFrame++;
+
+    step->time = clockTime;
+    step->frame = stepFrame;
+    step->renderTime = 0;
+
+    uv_mutex_unlock(&stepLock);
+
+    return step;
+}
+
+/**
+ * Frame was rendered.
+ *
+ * Note: called on rendering thread.
+ */
+void AminoGfx::stepDone(amino_step_t *step) {
+    enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfx::stepDoneHandler), static_cast<jsUpdateCallback>(&AminoGfx::freeStep), step);
+
+    //main thread has to process the callback before the next step
+    int res = uv_async_send(&asyncHandle);
+
+    assert(res == 0);
+}
+
+/**
+ * Call step callback on main thread.
+ */
+void AminoGfx::stepDoneHandler(JSCallbackUpdate *update) {
+    amino_step_t *step = (amino_step_t *)update->data;
+
+    if (!step->callback) {
+        return;
+    }
+
+    //create scope
+    Nan::HandleScope scope;
+
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    Nan::Set(obj, Nan::New("frame").ToLocalChecked(), Nan::New(step->frame));
+    Nan::Set(obj, Nan::New("time").ToLocalChecked(), Nan::New(step->time));
+    Nan::Set(obj, Nan::New("renderTime").ToLocalChecked(), Nan::New(step->renderTime));
+
+    int argc = 2;
+    v8::Local<v8::Value> argv[2] = { Nan::Null(), obj };
+
+    step->callback->Call(handle(), argc, argv);
+}
+
+/**
+ * Free step data.
+ */
+void AminoGfx::freeStep(JSCallbackUpdate *update) {
+    amino_step_t *step = (amino_step_t *)update->data;
+
+    if (step->callback) {
+        delete step->callback;
+    }
+
+    delete step;
+}
+
+/**
+ * Free all pending steps.
+ *
+ * Note: called on main thread after rendering thread was stopped.
+ */
+void AminoGfx::clearSteps() {
+    uv_mutex_lock(&stepLock);
+
+    while (!steps.empty()) {
+        amino_step_t *step = steps.front();
+
+        steps.pop();
+
+        if (step->callback) {
+            delete step->callback;
+        }
+
+        delete step;
+    }
+
+    uv_mutex_unlock(&stepLock);
+}
+
+/**
+ * Capture the next rendered frame.
+ *
+ * Parameters: callback(err, frame)
+ */
+NAN_METHOD(AminoGfx::CaptureFrame) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    //validate
+    if (!obj->started) {
+        Nan::ThrowTypeError("not started");
+        return;
+    }
+
+    if (info.Length() < 1 || !info[0]->IsFunction()) {
+        Nan::ThrowTypeError("missing callback");
+        return;
+    }
+
+    //enqueue
+    Nan::Callback *callback = new Nan::Callback(info[0].As<v8::Function>());
+
+    uv_mutex_lock(&obj->captureLock);
+    obj->captureCallbacks.push_back(callback);
+    uv_mutex_unlock(&obj->captureLock);
+
+    obj->wakeUp();
+}
+
+/**
+ * Capture frames continuously.
+ *
+ * Parameters: fps (0: every frame), callback(err, frame)
+ */
+NAN_METHOD(AminoGfx::StartCapture) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    //validate
+    if (!obj->started) {
+        Nan::ThrowTypeError("not started");
+        return;
+    }
+
+    if (info.Length() < 2 || !info[0]->IsNumber() || !info[1]->IsFunction()) {
+        Nan::ThrowTypeError("invalid parameters");
+        return;
+    }
+
+    double fps = info[0]->NumberValue();
+
+    //replace running capture
+    obj->stopCapture();
+
+    uv_mutex_lock(&obj->captureLock);
+
+    obj->captureInterval = fps > 0 ? 1000 / fps : 0;
+    obj->lastCaptureTime = 0;
+    obj->captureStreamCallback = new Nan::Callback(info[1].As<v8::Function>());
+
+    uv_mutex_unlock(&obj->captureLock);
+
+    obj->wakeUp();
+}
+
+/**
+ * Stop continuous capture.
+ */
+NAN_METHOD(AminoGfx::StopCapture) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    obj->stopCapture();
+}
+
+/**
+ * Stop continuous capture.
+ *
+ * Note: called on main thread.
+ */
+void AminoGfx::stopCapture() {
+    uv_mutex_lock(&captureLock);
+
+    if (captureStreamCallback) {
+        delete captureStreamCallback;
+        captureStreamCallback = NULL;
+    }
+
+    uv_mutex_unlock(&captureLock);
+}
+
+/**
+ * Free pending capture requests.
+ *
+ * Note: called on main thread.
+ */
+void AminoGfx::clearCaptures() {
+    stopCapture();
+
+    uv_mutex_lock(&captureLock);
+
+    for (std::size_t i = 0; i < captureCallbacks.size(); i++) {
+        delete captureCallbacks[i];
+    }
+
+    captureCallbacks.clear();
+
+    uv_mutex_unlock(&captureLock);
+}
+
+/**
+ * Check if a frame capture was requested.
+ */
+bool AminoGfx::isCapturePending() {
+    uv_mutex_lock(&captureLock);
+
+    bool pending = !captureCallbacks.empty() || captureStreamCallback;
+
+    uv_mutex_unlock(&captureLock);
+
+    return pending;
+}
+
+/**
+ * Read the rendered scene if a capture was requested.
+ *
+ * Note: called on rendering thread before the buffers are swapped.
+ */
+void AminoGfx::captureScene() {
+    uv_mutex_lock(&captureLock);
+
+    //check requests
+    bool single = !captureCallbacks.empty();
+    bool stream = false;
+    double time = getTime();
+
+    if (captureStreamCallback && (captureInterval <= 0 || lastCaptureTime == 0 || time - lastCaptureTime >= captureInterval)) {
+        stream = true;
+    }
+
+    if (!single && !stream) {
+        uv_mutex_unlock(&captureLock);
+        return;
+    }
+
+    //get free buffer
+    amino_capture_t *capture = NULL;
+
+    for (int i = 0; i < 2; i++) {
+        if (!captures[i].busy) {
+            capture = &captures[i];
+            break;
+        }
+    }
+
+    if (!capture) {
+        //both buffers in use: try again next frame
+        skippedCaptures++;
+
+        uv_mutex_unlock(&captureLock);
+        return;
+    }
+
+    if (stream) {
+        lastCaptureTime = time;
+    }
+
+    capture->busy = true;
+    capture->stream = stream;
+    capture->callbacks.swap(captureCallbacks);
+
+    uv_mutex_unlock(&captureLock);
+
+    //prepare buffer
+    int w = viewportW;
+    int h = viewportH;
+    size_t size = w * h * 4;
+
+    if (capture->size != size) {
+        capture->pixels = (char *)realloc(capture->pixels, size);
+        capture->size = size;
+
+        assert(capture->pixels);
+    }
+
+    capture->w = w;
+    capture->h = h;
+    capture->time = getClockTime();
+
+    //read pixels
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, capture->pixels);
+
+    if (DEBUG_CAPTURE) {
+        printf("captured frame: %ix%i (read: %i ms)\n", w, h, (int)(getTime() - time));
+    }
+
+    //convert on main thread
+    enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfx::captureReadyHandler), NULL, capture);
+
+    int res = uv_async_send(&asyncHandle);
+
+    assert(res == 0);
+}
+
+/**
+ * Pixels are ready, start conversion.
+ *
+ * Note: called on main thread.
+ */
+void AminoGfx::captureReadyHandler(JSCallbackUpdate *update) {
+    amino_capture_t *capture = (amino_capture_t *)update->data;
+
+    if (destroyed) {
+        v8::Local<v8::Object> empty;
+
+        frameCaptured(capture, empty);
+        return;
+    }
+
+    //keep instance (while converting)
+    retain();
+
+    Nan::AsyncQueueWorker(new AsyncFrameWorker(capture));
+}
+
+/**
+ * Frame was converted, call the receivers.
+ *
+ * Note: called on main thread.
+ */
+void AminoGfx::frameCaptured(amino_capture_t *capture, v8::Local<v8::Object> &buffer) {
+    bool converted = !buffer.IsEmpty();
+
+    if (converted && !destroyed) {
+        //create scope
+        Nan::HandleScope scope;
+
+        //frame
+        v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+        Nan::Set(obj, Nan::New("w").ToLocalChecked(), Nan::New(capture->w));
+        Nan::Set(obj, Nan::New("h").ToLocalChecked(), Nan::New(capture->h));
+        Nan::Set(obj, Nan::New("bpp").ToLocalChecked(), Nan::New(4));
+        Nan::Set(obj, Nan::New("time").ToLocalChecked(), Nan::New(capture->time));
+        Nan::Set(obj, Nan::New("buffer").ToLocalChecked(), buffer);
+
+        capturedFrames++;
+
+        int argc = 2;
+        v8::Local<v8::Value> argv[2] = { Nan::Null(), obj };
+
+        //single captures
+        for (std::size_t i = 0; i < capture->callbacks.size(); i++) {
+            capture->callbacks[i]->Call(handle(), argc, argv);
+        }
+
+        //stream
+        if (capture->stream && captureStreamCallback) {
+            captureStreamCallback->Call(handle(), argc, argv);
+        }
+    }
+
+    //free
+    for (std::size_t i = 0; i < capture->callbacks.size(); i++) {
+        delete capture->callbacks[i];
+    }
+
+    capture->callbacks.clear();
+
+    uv_mutex_lock(&captureLock);
+    capture->busy = false;
+    uv_mutex_unlock(&captureLock);
+
+    if (converted) {
+        release();
+    }
+}
+
+/**
+ * Check if rendering scene right now.
+ */
+bool AminoGfx::isRendering() {
+    return rendering;
+}
+
+/**
+ * Render the root node and all its children.
+ *
+ * Returns false if the frame was not drawn (partial redraw without changes).
+ */
+bool AminoGfx::renderScene() {
+    if (!root) {
+        return true;
+    }
+
+    if (viewportChanged) {
+        viewportChanged = false;
+
+        renderer->updateViewport(propW->value, propH->value, viewportW, viewportH);
+    }
+
+    int bufferAge = 0;
+
+    if (partialRedraw) {
+        //background color
+        GLfloat color[4] = { propR->value, propG->value, propB->value, propOpacity->value };
+
+        if (memcmp(color, clearColor, sizeof color) != 0) {
+            memcpy(clearColor, color, sizeof clearColor);
+            renderer->invalidateScene();
+        }
+
+        //read back the complete frame
+        if (isCapturePending()) {
+            renderer->invalidateScene();
+        }
+
+        bufferAge = getBufferAge();
+    }
+
+    if (!renderer->updateScene(root, bufferAge)) {
+        return false;
+    }
+
+    //damaged area
+    GLint rect[4];
+
+    if (renderer->getDamageRect(rect)) {
+        setDamageRegion(rect);
+    }
+
+    renderer->initScene(propR->value, propG->value, propB->value, propOpacity->value);
+    renderer->renderScene(root);
+
+    return true;
+}
+
+/**
+ * Get the age of the back buffer (partial redraw).
+ *
+ * Returns 0 if the content is unknown, 1 if the buffer contains the last frame.
+ */
+int AminoGfx::getBufferAge() {
+    //overwrite
+    return 0;
+}
+
+/**
+ * Limit the region of the back buffer which is updated.
+ *
+ * Note: rect contains x, y, w and h in window coordinates.
+ */
+void AminoGfx::setDamageRegion(GLint *rect) {
+    //empty: overwrite
+}
+
+/**
+ * Stop rendering and free resources.
+ */
+NAN_METHOD(AminoGfx::Destroy) {
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    if (!obj->destroyed) {
+        obj->destroy();
+    }
+}
+
+/**
+ * Stop rendering and free resources.
+ *
+ * Note: has to run on main thread.
+ */
+void AminoGfx::destroy() {
+    if (destroyed) {
+        return;
+    }
+
+    //instance
+    destroyAminoGfx();
+
+    //base destroy
+    AminoJSEventObject::destroy();
+}
+
+/**
+ * Stop rendering and free resources.
+ *
+ * Note: has to run on main thread.
+ */
+void AminoGfx::destroyAminoGfx() {
+    //stop thread
+    stopRenderingThread();
+
+    //pending captures
+    clearCaptures();
+
+    //bind context (to main thread)
+    if (started) {
+        started = false;
+
+        bool res = bindContext();
+
+        assert(res);
+
+        //renderer
+        if (renderer) {
+            delete renderer;
+            renderer = NULL;
+        }
+    }
+
+    //unbind root
+    setRoot(NULL);
+
+    //free async
+    clearAsyncQueue();
+    clearAnimations();
+    handleAsyncDeletes();
+
+    //params
+    createParams.Reset();
+
+    //debug
+    if (DEBUG_BASE) {
+        printf("AminoGfx destroyed -> %i references left\n", getReferenceCount());
+    }
+}
+
+/**
+ * Size has changed, update internal and JS properties.
+ *
+ * Note: has to be called after window size has changed. Does not touch the window size.
+ */
+void AminoGfx::updateSize(int w, int h) {
+    propW->setValue(w);
+    propH->setValue(h);
+}
+
+/**
+ * Position has changed, update internal and JS properties.
+ *
+ * Note: has to be called after window position has changed. Does not touch the window position.
+ */
+void AminoGfx::updatePosition(int x, int y) {
+    propX->setValue(x);
+    propY->setValue(y);
+}
+
+/**
+ * Fire runtime specific event.
+ *
+ * Note: has to be called on main thread!
+ */
+void AminoGfx::fireEvent(v8::Local<v8::Object> &evt) {
+    //event handler
+    v8::Local<v8::Object> obj = handle();
+    Nan::MaybeLocal<v8::Value> handleEventMaybe = Nan::Get(obj, Nan::New<v8::String>("handleEvent").ToLocalChecked());
+
+    if (!handleEventMaybe.IsEmpty()) {
+        v8::Local<v8::Value> value = handleEventMaybe.ToLocalChecked();
+
+        if (value->IsFunction()) {
+            v8::Local<v8::Function> func = value.As<v8::Function>();
+
+            //call
+            int argc = 1;
+            v8::Local<v8::Value> argv[1] = { evt };
+
+            func->Call(obj, argc, argv);
+        }
+    }
+}
+
+/**
+ * Handle sync property updates.
+ */
+bool AminoGfx::handleSyncUpdate(AnyProperty *property, void *data) {
+    //debug
+    //printf("handleSyncUpdate() %s\n", property->name.c_str());
+
+    //default: does nothing
+    bool res = AminoJSObject::handleSyncUpdate(property, data);
 
     //size changes
     if (property == propW || property == propH) {
@@ -877,36 +1802,138 @@ NAN_METHOD(AminoGfx::SetRoot) {
     } else {
         group = Nan::ObjectWrap::Unwrap<AminoGroup>(info[0]->ToObject());
 
-        assert(group);
+        assert(group);
+    }
+
+    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(obj);
+
+    obj->setRoot(group);
+}
+
+/**
+ * Set the root node.
+ */
+void AminoGfx::setRoot(AminoGroup *group) {
+    //validate
+    if (group && !group->checkRenderer(this)) {
+        return;
+    }
+
+    //free old one
+    if (root) {
+        root->release();
+    }
+
+    //set
+    root = group;
+
+    if (group) {
+        group->retain();
+    }
+}
+
+/**
+ * Set a float property of many nodes at once.
+ *
+ * Parameters: nodes (array), propId, values (Float32Array or array).
+ */
+NAN_METHOD(AminoGfx::SetProperties) {
+    assert(info.Length() == 3);
+
+    AminoGfx *gfx = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+
+    assert(gfx);
+
+    if (!info[0]->IsArray()) {
+        Nan::ThrowTypeError("expected array of nodes");
+        return;
+    }
+
+    v8::Local<v8::Array> nodes = info[0].As<v8::Array>();
+    int propId = info[1]->Int32Value();
+    std::size_t count = nodes->Length();
+
+    //values
+    v8::Local<v8::Value> valuesValue = info[2];
+    std::vector<float> valuesArray;
+    float *values = NULL;
+
+    if (valuesValue->IsFloat32Array()) {
+        v8::Local<v8::Float32Array> arr = valuesValue.As<v8::Float32Array>();
+
+        if (arr->Length() < count) {
+            Nan::ThrowRangeError("not enough values");
+            return;
+        }
+
+        v8::ArrayBuffer::Contents contents = arr->Buffer()->GetContents();
+
+        values = (float *)((char *)contents.Data() + arr->ByteOffset());
+    } else if (valuesValue->IsArray()) {
+        v8::Local<v8::Array> arr = valuesValue.As<v8::Array>();
+
+        if (arr->Length() < count) {
+            Nan::ThrowRangeError("not enough values");
+            return;
+        }
+
+        valuesArray.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            valuesArray.push_back((float)(arr->Get(i)->NumberValue()));
+        }
+
+        values = valuesArray.data();
+    } else {
+        Nan::ThrowTypeError("expected Float32Array or array");
+        return;
     }
 
-    AminoGfx *obj = Nan::ObjectWrap::Unwrap<AminoGfx>(info.This());
+    //collect properties
+    std::vector<AnyProperty *> props;
+    AnyProperty *firstProp = NULL;
 
-    assert(obj);
+    props.reserve(count);
 
-    obj->setRoot(group);
-}
+    for (std::size_t i = 0; i < count; i++) {
+        v8::Local<v8::Value> nodeValue = nodes->Get(i);
 
-/**
- * Set the root node.
- */
-void AminoGfx::setRoot(AminoGroup *group) {
-    //validate
-    if (group && !group->checkRenderer(this)) {
-        return;
-    }
+        if (!nodeValue->IsObject()) {
+            Nan::ThrowTypeError("expected node");
+            return;
+        }
 
-    //free old one
-    if (root) {
-        root->release();
-    }
+        AminoNode *node = Nan::ObjectWrap::Unwrap<AminoNode>(nodeValue.As<v8::Object>());
 
-    //set
-    root = group;
+        assert(node);
 
-    if (group) {
-        group->retain();
+        if (!node->checkRenderer(gfx)) {
+            return;
+        }
+
+        //Note: property ids depend on the node class
+        AnyProperty *prop = node->getPropertyWithId(propId);
+
+        if (firstProp && (!prop || prop->name != firstProp->name)) {
+            prop = node->getPropertyWithName(firstProp->name);
+        }
+
+        if (!prop || prop->type != PROPERTY_FLOAT) {
+            Nan::ThrowTypeError("property cannot be set");
+            return;
+        }
+
+        if (!firstProp) {
+            firstProp = prop;
+        }
+
+        props.push_back(prop);
     }
+
+    //enqueue (single queue operation)
+    gfx->enqueuePropertyUpdates(props, values);
 }
 
 /**
@@ -924,6 +1951,7 @@ NAN_METHOD(AminoGfx::UpdatePerspective) {
 
     //use in next rendering cycle
     gfx->viewportChanged = true;
+    gfx->wakeUp();
 }
 
 /**
@@ -945,6 +1973,9 @@ NAN_METHOD(AminoGfx::GetStats) {
  * Get runtime statistics.
  */
 void AminoGfx::getStats(v8::Local<v8::Object> &obj) {
+    //base
+    AminoJSEventObject::getStats(obj);
+
     //JS objects
     Nan::Set(obj, Nan::New("activeInstances").ToLocalChecked(), Nan::New(activeInstances));
     Nan::Set(obj, Nan::New("totalInstances").ToLocalChecked(), Nan::New(totalInstances));
@@ -955,6 +1986,26 @@ void AminoGfx::getStats(v8::Local<v8::Object> &obj) {
     //textures
     Nan::Set(obj, Nan::New("textures").ToLocalChecked(), Nan::New(textureCount));
 
+    //font atlas pages (all fonts)
+    AminoFont::getStats(obj);
+
+    //node storage
+    Nan::Set(obj, Nan::New("nodeSlots").ToLocalChecked(), Nan::New(nodeSlotCount - (int)freeNodeSlots.size()));
+    Nan::Set(obj, Nan::New("nodeChunks").ToLocalChecked(), Nan::New((uint32_t)nodeChunks.size()));
+
+    //idle time (milliseconds)
+    Nan::Set(obj, Nan::New("idleTime").ToLocalChecked(), Nan::New(idleTime));
+
+    //frame capture
+    Nan::Set(obj, Nan::New("capturedFrames").ToLocalChecked(), Nan::New(capturedFrames));
+    Nan::Set(obj, Nan::New("skippedCaptures").ToLocalChecked(), Nan::New(skippedCaptures));
+
+    //frame stepping
+    if (stepping) {
+        Nan::Set(obj, Nan::New("frame").ToLocalChecked(), Nan::New(stepFrame));
+        Nan::Set(obj, Nan::New("clockTime").ToLocalChecked(), Nan::New(getClockTime()));
+    }
+
     //rendering performance (FPS)
     if (MEASURE_FPS && lastFPS) {
         v8::Local<v8::Object> fpsObj = Nan::New<v8::Object>();
@@ -968,6 +2019,9 @@ void AminoGfx::getStats(v8::Local<v8::Object> &obj) {
     }
 
     //renderer
+    if (renderer) {
+        renderer->getStats(obj);
+    }
 
     if (SHOW_RENDERER_ERRORS) {
         Nan::Set(obj, Nan::New("errors").ToLocalChecked(), Nan::New(rendererErrors));
@@ -1005,6 +2059,8 @@ bool AminoGfx::addAnimation(AminoAnim *anim) {
     res = pthread_mutex_unlock(&animLock);
     assert(res == 0);
 
+    wakeUp();
+
     return true;
 }
 
@@ -1183,6 +2239,49 @@ void AminoGfx::deleteVertexBuffer(AsyncValueUpdate *update, int state) {
     vertex_buffer_delete(buffer);
 }
 
+/**
+ * Free the cached layer of a group.
+ *
+ * Note: has to be called on main thread.
+ */
+bool AminoGfx::deleteLayerAsync(AminoGroup *group) {
+    if (destroyed) {
+        return false;
+    }
+
+    if (DEBUG_BASE) {
+        printf("enqueue: delete layer\n");
+    }
+
+    //enqueue
+    AminoJSObject::enqueueValueUpdate(0, group, static_cast<asyncValueCallback>(&AminoGfx::deleteLayer));
+
+    return true;
+}
+
+/**
+ * Delete layer (on OpenGL thread).
+ */
+void AminoGfx::deleteLayer(AsyncValueUpdate *update, int state) {
+    if (state != AsyncValueUpdate::STATE_APPLY) {
+        return;
+    }
+
+    //Note: group might be deleted (only used as key)
+    freeLayer((AminoGroup *)update->data);
+}
+
+/**
+ * Free the cached layer of a group.
+ *
+ * Note: called on rendering thread.
+ */
+void AminoGfx::freeLayer(AminoGroup *group) {
+    if (renderer) {
+        renderer->removeLayer(group);
+    }
+}
+
 /**
  * Collect text updates.
  */
@@ -1192,84 +2291,64 @@ void AminoGfx::textUpdateNeeded(AminoText *text) {
     }
 }
 
+/**
+ * Collect atlas pages with new glyphs.
+ *
+ * Note: called on rendering thread.
+ */
+void AminoGfx::atlasTextureUpdateNeeded(amino_atlas_page_t *page) {
+    if (std::find(atlasTextureUpdates.begin(), atlasTextureUpdates.end(), page) == atlasTextureUpdates.end()) {
+        atlasTextureUpdates.push_back(page);
+    }
+}
+
 /**
  * Update all modified text nodes.
  */
 void AminoGfx::updateTextNodes() {
+    //layout modified texts (on worker threads)
     std::size_t count = textUpdates.size();
 
-    if (count == 0) {
-        return;
-    }
-
-#if (DEBUG_FONT_PERFORMANCE == 1)
-    //debug
-    double startTime = getTime(), diff;
-#endif
-
-    //layout modified texts
-    std::vector<AminoText *> textureUpdates;
-
     for (std::size_t i = 0; i < count; i++) {
-        AminoText *item = textUpdates[i];
-
-        if (item->layoutText()) {
-            //find texture
-            std::size_t textureCount = textureUpdates.size();
-            GLuint textureId = item->getTextureId();
-            bool found = false;
-
-            for (std::size_t j = 0; j < textureCount; j++) {
-                AminoText *item2 = textureUpdates[j];
-
-                if (item2->getTextureId() == textureId) {
-                    found = true;
-                    break;
-                }
-            }
-
-            if (!found) {
-                textureUpdates.push_back(item);
-            }
-        }
+        textUpdates[i]->startLayout();
     }
 
     textUpdates.clear();
 
-#if (DEBUG_FONT_PERFORMANCE == 1)
-    //debug
-    diff = getTime() - startTime;
-    if (diff > 5) {
-        printf("layoutText: %i ms\n", (int)diff);
-    }
-#endif
-
-    //update textures
-    std::size_t textureCount = textureUpdates.size();
+    //update textures (of finished layouts)
+    std::size_t textureCount = atlasTextureUpdates.size();
 
+    if (textureCount > 0) {
 #if (DEBUG_FONT_PERFORMANCE == 1)
-    //debug
-    startTime = getTime();
+        //debug
+        double startTime = getTime(), diff;
 #endif
 
-    for (std::size_t i = 0; i < textureCount; i++) {
-        AminoText *item = textureUpdates[i];
+        for (std::size_t i = 0; i < textureCount; i++) {
+            amino_atlas_page_t *page = atlasTextureUpdates[i];
+            bool newTexture;
+            amino_atlas_t texture = getAtlasTexture(page->atlas, false, newTexture);
 
-        item->updateTexture();
+            if (texture.textureId == INVALID_TEXTURE) {
+                continue;
+            }
 
-        //inform other amino instances to update shared texture
-        texture_atlas_t *atlas = item->fontSize->fontTexture->atlas;
+            AminoText::updateTextureFromAtlas(texture.textureId, page);
 
-        atlasTextureHasChanged(atlas);
-    }
+            //inform other amino instances to update shared texture
+            atlasTextureHasChanged(page);
+        }
+
+        atlasTextureUpdates.clear();
 
 #if (DEBUG_FONT_PERFORMANCE == 1)
-    //debug
-    diff = getTime() - startTime;
-    if (diff > 5) {
-        printf("updateTexture: %i ms\n", (int)diff);
-    }
+        //debug
+        diff = getTime() - startTime;
+        if (diff > 5) {
+            printf("updateTexture: %i ms\n", (int)diff);
+        }
 #endif
+    }
 }
 
 /**
@@ -1277,7 +2356,7 @@ void AminoGfx::updateTextNodes() {
  *
  * Note: called on rendering thread.
  */
-void AminoGfx::atlasTextureHasChanged(texture_atlas_t *atlas) {
+void AminoGfx::atlasTextureHasChanged(amino_atlas_page_t *page) {
     //overwrite
 }
 
@@ -1286,10 +2365,10 @@ void AminoGfx::atlasTextureHasChanged(texture_atlas_t *atlas) {
  *
  * Note: called on main thread
  */
-void AminoGfx::updateAtlasTexture(texture_atlas_t *atlas) {
+void AminoGfx::updateAtlasTexture(amino_atlas_page_t *page) {
     //check if texture exists
     bool newTexture;
-    amino_atlas_t texture = getAtlasTexture(atlas, false, newTexture);
+    amino_atlas_t texture = getAtlasTexture(page->atlas, false, newTexture);
 
     if (texture.textureId != INVALID_TEXTURE) {
         if (DEBUG_BASE) {
@@ -1297,7 +2376,7 @@ void AminoGfx::updateAtlasTexture(texture_atlas_t *atlas) {
         }
 
         //switch to rendering thread
-        AminoJSObject::enqueueValueUpdate(texture.textureId, atlas, static_cast<asyncValueCallback>(&AminoGfx::updateAtlasTextureHandler));
+        AminoJSObject::enqueueValueUpdate(texture.textureId, page, static_cast<asyncValueCallback>(&AminoGfx::updateAtlasTextureHandler));
     }
 }
 
@@ -1312,9 +2391,9 @@ void AminoGfx::updateAtlasTextureHandler(AsyncValueUpdate *update, int state) {
     //debug
     //printf("%p: texture update %i\n", this, (int)update->valueUint32);
 
-    texture_atlas_t *atlas = (texture_atlas_t *)update->data;
+    amino_atlas_page_t *page = (amino_atlas_page_t *)update->data;
 
-    AminoText::updateTextureFromAtlas(update->valueUint32, atlas);
+    AminoText::updateTextureFromAtlas(update->valueUint32, page);
 }
 
 /**
@@ -1340,9 +2419,9 @@ void AminoGfx::notifyTextureCreated(int count) {
  *
  * Note: called on main thread.
  */
-void AminoGfx::updateAtlasTextures(texture_atlas_t *atlas) {
+void AminoGfx::updateAtlasTextures(amino_atlas_page_t *page) {
     for (auto const &item : instances) {
-        item->updateAtlasTexture(atlas);
+        item->updateAtlasTexture(page);
     }
 }
 
@@ -1462,34 +2541,20 @@ AminoJSObject* AminoTextFactory::create() {
 // AminoText
 //
 
-/**
- * Update texture.
- */
-void AminoText::updateTexture() {
-    if (DEBUG_FONT_UPDATES) {
-        printf("-> update font texture: %s\n", fontSize->font->getFontInfo().c_str());
-    }
-
-    assert(texture.textureId != INVALID_TEXTURE);
-    assert(fontSize);
-    assert(fontSize->fontTexture);
-
-    texture_atlas_t *atlas = fontSize->fontTexture->atlas;
-
-    assert(atlas);
-
-    updateTextureFromAtlas(texture.textureId, atlas);
-}
-
 /**
  * Update texture from atlas.
  */
-void AminoText::updateTextureFromAtlas(GLuint textureId, texture_atlas_t *atlas) {
+void AminoText::updateTextureFromAtlas(GLuint textureId, amino_atlas_page_t *page) {
     //update texture
     if (DEBUG_BASE) {
         printf("-> updateTexture()\n");
     }
 
+    //atlas data is modified by layouts on worker threads
+    texture_atlas_t *atlas = page->atlas;
+
+    page->font->lock();
+
     if (DEBUG_FONT_TEXTURE) {
         //output as ASCII art
         int maxW = std::min(80, (int)atlas->width);
@@ -1534,21 +2599,27 @@ void AminoText::updateTextureFromAtlas(GLuint textureId, texture_atlas_t *atlas)
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, atlas->width, atlas->height, 0, GL_RGB, GL_UNSIGNED_BYTE, atlas->data);
     }
 
+    page->font->unlock();
+
     //printf("font texture updated\n");
     //printf("updateTexture() done\n");
 }
 
 /**
- * Get the font texture.
+ * Release the atlas pages of the current glyphs.
  */
-GLuint AminoText::getTextureId() {
-    return texture.textureId;
+void AminoText::releaseAtlasRanges() {
+    for (auto const &range : atlasRanges) {
+        AminoFont::releaseAtlasPage(range.page);
+    }
+
+    atlasRanges.clear();
 }
 
 /**
  * Render text to vertices.
  */
-void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, const char *text, vec2 *pen, int wrap, int width, int *lineNr, int maxLines, float *lineW) {
+void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, const char *text, vec2 *pen, int wrap, int width, int *lineNr, int maxLines, float *lineW, std::vector<texture_atlas_t *> *atlases) {
     //see https://github.com/rougier/freetype-gl/blob/master/demos/glyph.c
     size_t len = utf8_strlen(text);
 
@@ -1564,7 +2635,7 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
 
     //add glyphs (by iterating Unicode characters)
     char *textPos = (char *)text;
-    char *lastTextPos = NULL;
+    texture_glyph_t *lastGlyph = NULL;
     uint32_t textUtf32[len];
     bool done = false;
 
@@ -1578,8 +2649,8 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
             //kerning
             int kerning = 0;
 
-            if (linePos > 0) {
-                kerning = texture_glyph_get_kerning(glyph, lastTextPos);
+            if (linePos > 0 && lastGlyph) {
+                kerning = texture_font_get_kerning(font, lastGlyph, glyph);
             }
 
             //wrap
@@ -1644,6 +2715,10 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
                             vertex_buffer_erase(buffer, start);
                             count--;
 
+                            if (atlases) {
+                                atlases->erase(atlases->begin() + start);
+                            }
+
                             //update existing glyphs
                             float xOffset = pen->x; //case: space before
 
@@ -1686,6 +2761,10 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
                                 for (size_t j = start; j < count; j++) {
                                     vertex_buffer_erase(buffer, start);
                                 }
+
+                                if (atlases) {
+                                    atlases->erase(atlases->begin() + start, atlases->end());
+                                }
                             }
                         }
                     }
@@ -1751,6 +2830,10 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
                 vertex_buffer_push_back(buffer, vertices, 4, indices, 6);
                 linePos++;
 
+                if (atlases) {
+                    atlases->push_back(glyph->atlas);
+                }
+
                 //next
                 pen->x += advance;
             }
@@ -1776,7 +2859,7 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
         //next glyph pos
         size_t charLen = utf8_surrogate_len(textPos);
 
-        lastTextPos = textPos;
+        lastGlyph = glyph;
         textPos += charLen;
     }
 
@@ -1784,77 +2867,306 @@ void AminoText::addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, con
 }
 
 /**
- * Update the rendered text.
+ * Start laying out the text on a worker thread (synchronously in frame stepping mode).
  *
- * Returns true if texture has changed and must be updated.
+ * Note: called on rendering thread.
  */
-bool AminoText::layoutText() {
-    //printf("layoutText()\n");
-
+void AminoText::startLayout() {
     if (!fontSize) {
         //printf("-> no font\n");
 
-        return false;
+        return;
     }
 
-    if (DEBUG_FONT_UPDATES) {
-        printf("->layoutText() render text (%s)\n", fontSize->font->fontName.c_str());
+    //one layout at a time (repeated when done)
+    if (layoutPending) {
+        layoutDirty = true;
+
+        return;
     }
 
-    //Note: FreeType glyph code is not thread-safe, using lock to prevent crash on macOS if multiple AminoGfx instances are active
-    uv_mutex_lock(&freeTypeMutex);
+    if (DEBUG_FONT_UPDATES) {
+        printf("->startLayout() render text (%s)\n", fontSize->font->fontName.c_str());
+    }
 
-    //create texture (needed in next calls)
     assert(fontSize->fontTexture);
 
-    texture_atlas_t *atlas = fontSize->fontTexture->atlas;
-    bool newTexture;
+    //snapshot
+    text_layout_t *layout = new text_layout_t();
 
-    assert(atlas);
-    assert(atlas->depth == 1);
+    layout->fontSize = fontSize;
+    layout->text = propText->value;
+    layout->wrap = wrap;
+    layout->width = propW->value;
+    layout->maxLines = propMaxLines->value;
+    layout->buffer = NULL;
 
-    if (texture.textureId == INVALID_TEXTURE) {
-        //create or use existing texture (for atlas)
-        texture = getAminoGfx()->getAtlasTexture(atlas, true, newTexture);
+    //frame stepping: ready in the current frame
+    if (getAminoGfx()->isStepping()) {
+        layoutText(layout);
+        applyLayout(layout);
+        deleteLayout(layout);
 
-        assert(texture.textureId != INVALID_TEXTURE);
+        return;
     }
 
-    //render text
-    if (buffer) {
-        vertex_buffer_clear(buffer);
-    } else {
-        //vertex & texture coordinates
-        buffer = vertex_buffer_new("pos:3f,texCoord:2f");
+    //switch to main thread
+    if (!enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoText::layoutReadyHandler), NULL, layout)) {
+        delete layout;
+
+        return;
     }
 
-    texture_font_t *fontTexture = fontSize->fontTexture;
-    size_t lastGlyphCount = fontTexture->glyphs->size;
+    layoutPending = true;
+}
+
+/**
+ * Queue the layout.
+ *
+ * Note: called on main thread.
+ */
+void AminoText::layoutReadyHandler(JSCallbackUpdate *update) {
+    text_layout_t *layout = (text_layout_t *)update->data;
+
+    if (destroyed) {
+        delete layout;
+
+        return;
+    }
+
+    //keep instances (while rendering glyphs)
+    retain();
+    layout->fontSize->retain();
+
+    Nan::AsyncQueueWorker(new AsyncTextLayoutWorker(this, layout));
+}
+
+/**
+ * Render glyphs and vertices.
+ *
+ * Note: called on worker thread.
+ */
+void AminoText::layoutText(text_layout_t *layout) {
+    //vertex & texture coordinates
+    layout->buffer = vertex_buffer_new("pos:3f,texCoord:2f");
+
+    //Note: FreeType is only thread-safe per library (and the atlas is shared by all sizes)
+    AminoFont *font = layout->fontSize->font;
+
+    font->lock();
+
+    texture_font_t *fontTexture = layout->fontSize->fontTexture;
 
     assert(fontTexture);
 
-    vec2 pen;
+    size_t lastGlyphCount = fontTexture->glyphs->size;
+    std::vector<texture_atlas_t *> atlases;
+    float scale = layout->fontSize->scale;
+    int pass;
+
+    for (pass = 0; ; pass++) {
+        vec2 pen;
+
+        pen.x = 0;
+        pen.y = 0;
+
+        vertex_buffer_clear(layout->buffer);
+        atlases.clear();
+        fontTexture->atlas_full = 0;
 
-    pen.x = 0;
-    pen.y = 0;
+        addTextGlyphs(layout->buffer, fontTexture, layout->text.c_str(), &pen, layout->wrap, layout->width / scale, &layout->lineNr, layout->maxLines, &layout->lineW, &atlases);
 
-    //Note: consider using async task to avoid performance issues
-    addTextGlyphs(buffer, fontTexture, propText->value.c_str(), &pen, wrap, propW->value, &lineNr, propMaxLines->value, &lineW);
+        //retry on next atlas page (previous glyphs might have been evicted)
+        if (!fontTexture->atlas_full || pass + 1 >= ATLAS_MAX_PAGES || !font->nextAtlasPage()) {
+            break;
+        }
+    }
+
+    layout->glyphsChanged = lastGlyphCount != fontTexture->glyphs->size || pass > 0;
+
+    //one draw call per atlas page
+    groupGlyphsByAtlas(layout, atlases);
+
+    font->unlock();
+
+    //SDF font: glyph size to font size
+    if (scale != 1) {
+        vertex_buffer_t *buffer = layout->buffer;
+        size_t count = vector_size(buffer->vertices);
+
+        for (size_t i = 0; i < count; i++) {
+            vertex_t *vertex = (vertex_t *)vector_get(buffer->vertices, i);
+
+            vertex->x *= scale;
+            vertex->y *= scale;
+        }
+
+        layout->lineW *= scale;
+    }
 
     if (DEBUG_BASE) {
         printf("-> layoutText() done\n");
     }
+}
+
+/**
+ * Sort the glyph indices by atlas page and keep the pages in use.
+ *
+ * Note: font has to be locked.
+ */
+void AminoText::groupGlyphsByAtlas(text_layout_t *layout, std::vector<texture_atlas_t *> &atlases) {
+    vertex_buffer_t *buffer = layout->buffer;
+    AminoFont *font = layout->fontSize->font;
+    size_t count = atlases.size();
+    std::vector<GLushort> indices;
+
+    assert(count == vertex_buffer_size(buffer));
+
+    indices.reserve(buffer->indices->size);
+
+    for (size_t i = 0; i < count; i++) {
+        texture_atlas_t *atlas = atlases[i];
+
+        if (!atlas) {
+            //already added
+            continue;
+        }
+
+        text_atlas_range_t range;
+
+        range.page = font->acquireAtlasPage(atlas);
+        range.textureId = INVALID_TEXTURE;
+        range.start = indices.size();
+
+        for (size_t j = i; j < count; j++) {
+            if (atlases[j] != atlas) {
+                continue;
+            }
+
+            ivec4 *item = (ivec4 *)vector_get(buffer->items, j);
+            GLushort *first = (GLushort *)vector_get(buffer->indices, item->z);
+
+            indices.insert(indices.end(), first, first + item->w);
+            atlases[j] = NULL;
+        }
+
+        range.count = indices.size() - range.start;
+        layout->ranges.push_back(range);
+    }
+
+    //reorder (Note: item index ranges are no longer valid)
+    if (layout->ranges.size() > 1) {
+        memcpy(buffer->indices->items, indices.data(), indices.size() * sizeof(GLushort));
+    }
+}
+
+/**
+ * Layout is ready, switch to rendering thread.
+ *
+ * Note: called on main thread.
+ */
+void AminoText::layoutDone(text_layout_t *layout) {
+    AminoJSObject::enqueueValueUpdate(0, layout, static_cast<asyncValueCallback>(&AminoText::layoutDoneHandler));
+
+    release();
+}
+
+/**
+ * Use the new vertices.
+ */
+void AminoText::layoutDoneHandler(AsyncValueUpdate *update, int state) {
+    text_layout_t *layout = (text_layout_t *)update->data;
+
+    if (state == AsyncValueUpdate::STATE_APPLY) {
+        //rendering thread
+        layoutPending = false;
+
+        if (destroyed) {
+            return;
+        }
+
+        applyLayout(layout);
+    } else if (state == AsyncValueUpdate::STATE_DELETE) {
+        //main thread
+        layout->fontSize->release();
+
+        deleteLayout(layout);
+    }
+}
+
+/**
+ * Switch to the vertices and atlas pages of a layout.
+ *
+ * Note: called on rendering thread.
+ */
+void AminoText::applyLayout(text_layout_t *layout) {
+    if (layout->fontSize == fontSize) {
+        //switch buffers
+        if (buffer) {
+            vertex_buffer_delete(buffer);
+        }
+
+        buffer = layout->buffer;
+        layout->buffer = NULL;
+
+        lineNr = layout->lineNr;
+        lineW = layout->lineW;
+
+        //switch atlas pages
+        releaseAtlasRanges();
+        atlasRanges.swap(layout->ranges);
+
+        for (auto &range : atlasRanges) {
+            //create or use existing texture (for atlas page)
+            texture_atlas_t *atlas = range.page->atlas;
+            bool newTexture = false;
+
+            assert(atlas->depth == 1);
+
+            range.textureId = getAminoGfx()->getAtlasTexture(atlas, true, newTexture).textureId;
 
-    size_t newGlyphCount = fontTexture->glyphs->size;
-    bool glyphsChanged = lastGlyphCount != newGlyphCount || (newTexture && newGlyphCount > 0);
+            assert(range.textureId != INVALID_TEXTURE);
 
-    uv_mutex_unlock(&freeTypeMutex);
+            if (newTexture) {
+                getAminoGfx()->atlasTextureUpdateNeeded(range.page);
+            }
+        }
+
+        //bounds changed
+        invalidateRender();
+    }
 
     //debug
-    //printf("glyphs changed: %i\n", glyphsChanged);
+    //printf("glyphs changed: %i\n", layout->glyphsChanged);
+
+    if (layout->glyphsChanged) {
+        //current or previous font (if texture exists)
+        const std::vector<text_atlas_range_t> &ranges = layout->fontSize == fontSize ? atlasRanges:layout->ranges;
+
+        for (auto const &range : ranges) {
+            getAminoGfx()->atlasTextureUpdateNeeded(range.page);
+        }
+    }
 
-    return glyphsChanged;
+    //modified in the meantime
+    if (layoutDirty) {
+        layoutDirty = false;
+        getAminoGfx()->textUpdateNeeded(this);
+    }
 }
 
-uv_mutex_t AminoText::freeTypeMutex;
-bool AminoText::freeTypeMutexInitialized = false;
\ No newline at end of file
+/**
+ * Free the layout.
+ */
+void AminoText::deleteLayout(text_layout_t *layout) {
+    if (layout->buffer) {
+        vertex_buffer_delete(layout->buffer);
+    }
+
+    //unused atlas pages
+    for (auto const &range : layout->ranges) {
+        AminoFont::releaseAtlasPage(range.page);
+    }
+
+    delete layout;
+}
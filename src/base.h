@@ -12,7 +12,9 @@
 #include "mathutils.h"
 #include <stdio.h>
 #include <vector>
+#include <algorithm>
 #include <stack>
+#include <queue>
 #include <stdlib.h>
 #include <string>
 #include <map>
@@ -25,6 +27,15 @@
 
 #define DEBUG_CRASH false
 
+//wait time if the frame is not drawn (partial redraw)
+#define IDLE_FRAME_TIME (1000000 / 60)
+
+//system event polling interval in milliseconds (also while idle)
+#define EVENT_POLL_INTERVAL 10
+
+//nodes per storage chunk
+#define NODE_CHUNK_SIZE 256
+
 const int GROUP = 1;
 const int RECT  = 2;
 const int TEXT  = 3;
@@ -32,11 +43,65 @@ const int ANIM  = 4;
 const int POLY  = 5;
 const int MODEL = 6;
 
+class AminoGfx;
 class AminoText;
 class AminoGroup;
 class AminoAnim;
 class AminoRenderer;
 
+/**
+ * Manual clock step.
+ */
+typedef struct {
+    double dt;
+    Nan::Callback *callback;
+
+    //result
+    int frame;
+    double time;
+    double renderTime;
+} amino_step_t;
+
+/**
+ * Frame capture buffer.
+ */
+typedef struct {
+    AminoGfx *gfx;
+    bool busy;
+
+    //pixels (RGBA, bottom-up)
+    char *pixels;
+    size_t size;
+    int w;
+    int h;
+    double time;
+
+    //receivers
+    std::vector<Nan::Callback *> callbacks;
+    bool stream;
+} amino_capture_t;
+
+/**
+ * Node value storage (structure of arrays).
+ *
+ * Note: chunks are never moved, properties keep pointers to their values.
+ */
+typedef struct {
+    //transform
+    GLfloat x[NODE_CHUNK_SIZE];
+    GLfloat y[NODE_CHUNK_SIZE];
+    GLfloat z[NODE_CHUNK_SIZE];
+    GLfloat sx[NODE_CHUNK_SIZE];
+    GLfloat sy[NODE_CHUNK_SIZE];
+    GLfloat rx[NODE_CHUNK_SIZE];
+    GLfloat ry[NODE_CHUNK_SIZE];
+    GLfloat rz[NODE_CHUNK_SIZE];
+
+    //opacity & visibility
+    GLfloat opacity[NODE_CHUNK_SIZE];
+    bool visible[NODE_CHUNK_SIZE];
+} amino_node_chunk_t;
+
 /**
  * Amino main class to call from JavaScript.
  *
@@ -52,19 +117,37 @@ public:
     bool addAnimation(AminoAnim *anim);
     void removeAnimation(AminoAnim *anim);
 
+    //idle
+    void wakeUp();
+
+    //frame stepping
+    bool isStepping();
+
+    //node storage
+    int allocNodeSlot(amino_node_chunk_t *&chunk, int &index);
+    void freeNodeSlot(int slot);
+
     bool deleteTextureAsync(GLuint textureId);
     bool deleteBufferAsync(GLuint bufferId);
     bool deleteVertexBufferAsync(vertex_buffer_t *buffer);
 
+    //layers
+    bool deleteLayerAsync(AminoGroup *group);
+    void freeLayer(AminoGroup *group);
+
     //text
     void textUpdateNeeded(AminoText *text);
+    void atlasTextureUpdateNeeded(amino_atlas_page_t *page);
     amino_atlas_t getAtlasTexture(texture_atlas_t *atlas, bool createIfMissing, bool &newTexture);
     void notifyTextureCreated(int count);
-    static void updateAtlasTextures(texture_atlas_t *atlas);
+    static void updateAtlasTextures(amino_atlas_page_t *page);
 
     //video
     virtual AminoVideoPlayer *createVideoPlayer(AminoTexture *texture, AminoVideo *video) = 0;
 
+    //capture
+    void frameCaptured(amino_capture_t *capture, v8::Local<v8::Object> &buffer);
+
 protected:
     static int instanceCount;
     static std::vector<AminoGfx *> instances;
@@ -79,11 +162,20 @@ protected:
     //renderer
     AminoRenderer *renderer = NULL;
     AminoGroup *root = NULL;
+
+    //node storage
+    std::vector<amino_node_chunk_t *> nodeChunks;
+    std::vector<int> freeNodeSlots;
+    int nodeSlotCount = 0;
     int viewportW;
     int viewportH;
     bool viewportChanged;
     int32_t swapInterval = 0;
     int rendererErrors = 0;
+
+    //partial redraw
+    bool partialRedraw = false;
+    GLfloat clearColor[4] = { -1, -1, -1, -1 };
     int textureCount = 0;
 
     //instance
@@ -92,10 +184,11 @@ protected:
 
     //text
     std::vector<AminoText *> textUpdates;
+    std::vector<amino_atlas_page_t *> atlasTextureUpdates;
 
     void updateTextNodes();
-    virtual void atlasTextureHasChanged(texture_atlas_t *atlas);
-    void updateAtlasTexture(texture_atlas_t *atlas);
+    virtual void atlasTextureHasChanged(amino_atlas_page_t *page);
+    void updateAtlasTexture(amino_atlas_page_t *page);
     void updateAtlasTextureHandler(AsyncValueUpdate *update, int state);
 
     //performance (FPS)
@@ -117,6 +210,7 @@ protected:
     uv_thread_t thread;
     bool threadRunning = false;
     uv_async_t asyncHandle;
+    uv_timer_t eventTimer;
 
     //properties
     FloatProperty *propX;
@@ -139,6 +233,30 @@ protected:
     std::vector<AminoAnim *> animations;
     pthread_mutex_t animLock; //Note: short cycles
 
+    //manual clock (frame stepping)
+    bool stepping = false;
+    double clockTime = 0;
+    int stepFrame = 0;
+    std::queue<amino_step_t *> steps;
+    uv_mutex_t stepLock;
+    uv_cond_t stepCond;
+
+    //idle (no changes)
+    bool idleWakeUp = false;
+    double idleTime = 0;
+    uv_mutex_t idleLock;
+    uv_cond_t idleCond;
+
+    //frame capture (double buffered)
+    amino_capture_t captures[2];
+    std::vector<Nan::Callback *> captureCallbacks;
+    Nan::Callback *captureStreamCallback = NULL;
+    double captureInterval = 0;
+    double lastCaptureTime = 0;
+    int capturedFrames = 0;
+    int skippedCaptures = 0;
+    uv_mutex_t captureLock;
+
     //creation
     static void Init(Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE target, AminoJSObjectFactory* factory);
 
@@ -158,14 +276,25 @@ protected:
     bool isRenderingThreadRunning();
     static void renderingThread(void *arg);
     static void handleRenderEvents(uv_async_t *handle);
+    static void handleEventTimer(uv_timer_t *handle);
     virtual void handleSystemEvents() = 0;
 
     virtual void initRendering();
     virtual void render();
     virtual void endRendering();
     void processAnimations();
+    bool isIdle();
+    void waitForChanges();
+    void asyncUpdateAdded() override;
+    double getClockTime();
+    amino_step_t* waitForStep();
+    void stepDone(amino_step_t *step);
     virtual bool bindContext() = 0;
-    virtual void renderScene();
+    virtual bool renderScene();
+    virtual int getBufferAge();
+    virtual void setDamageRegion(GLint *rect);
+    void captureScene();
+    bool isCapturePending();
     virtual void renderingDone() = 0;
     bool isRendering();
 
@@ -193,18 +322,35 @@ private:
     static NAN_METHOD(Destroy);
 
     static NAN_METHOD(SetRoot);
+    static NAN_METHOD(SetProperties);
     static NAN_METHOD(ClearAnimations);
     static NAN_METHOD(UpdatePerspective);
     static NAN_METHOD(GetStats);
     static NAN_METHOD(GetTime);
+    static NAN_METHOD(GetClockTime);
+    static NAN_METHOD(Step);
+    static NAN_METHOD(CaptureFrame);
+    static NAN_METHOD(StartCapture);
+    static NAN_METHOD(StopCapture);
 
     //animation
     void clearAnimations();
 
+    //frame stepping
+    void stepDoneHandler(JSCallbackUpdate *update);
+    void freeStep(JSCallbackUpdate *update);
+    void clearSteps();
+
+    //frame capture
+    void captureReadyHandler(JSCallbackUpdate *update);
+    void stopCapture();
+    void clearCaptures();
+
     //texture & buffer
     void deleteTexture(AsyncValueUpdate *update, int state);
     void deleteBuffer(AsyncValueUpdate *update, int state);
     void deleteVertexBuffer(AsyncValueUpdate *update, int state);
+    void deleteLayer(AsyncValueUpdate *update, int state);
 
     //stats
     void getStats(v8::Local<v8::Object> &obj) override;
@@ -249,12 +395,43 @@ public:
     //visibility
     BooleanProperty *propVisible;
 
+    //value storage (see AminoGfx)
+    int storeSlot = -1;
+    amino_node_chunk_t *store = NULL;
+    int storeIndex = 0;
+
+    //hierarchy (set by parent group)
+    AminoNode *parent = NULL;
+
+    //transform cache
+    bool localDirty = true;
+    bool worldValid = false;
+    bool localAffine = false; //2D affine (see mul_matrix_affine)
+    bool worldAffine = false;
+    GLfloat localMatrix[16];
+    GLfloat worldMatrix[16];
+
+    //render cache (see AminoRenderer)
+    bool renderDirty = true;
+    bool renderChildDirty = false;
+    bool layerDirty = true;
+    GLfloat renderOpacity = 1;
+    GLfloat renderClip[4];
+    GLfloat renderBounds[4];
+    bool renderHasBounds = false;
+    bool renderCulled = false;
+    int renderCullCount = 0;
+    size_t renderCmdIndex = 0;
+    size_t renderCmdCount = 0;
+
     AminoNode(std::string name, int type): AminoJSObject(name), type(type) {
         //empty
     }
 
     ~AminoNode() {
-        //see destroy
+        if (!destroyed) {
+            destroyAminoNode();
+        }
     }
 
     void preInit(Nan::NAN_METHOD_ARGS_TYPE info) override {
@@ -274,20 +451,23 @@ public:
     void setup() override {
         AminoJSObject::setup();
 
+        //values storage
+        storeSlot = getAminoGfx()->allocNodeSlot(store, storeIndex);
+
         //register native properties
-        propX = createFloatProperty("x");
-        propY = createFloatProperty("y");
-        propZ = createFloatProperty("z");
+        propX = createFloatProperty("x", &store->x[storeIndex]);
+        propY = createFloatProperty("y", &store->y[storeIndex]);
+        propZ = createFloatProperty("z", &store->z[storeIndex]);
 
-        propScaleX = createFloatProperty("sx");
-        propScaleY = createFloatProperty("sy");
+        propScaleX = createFloatProperty("sx", &store->sx[storeIndex]);
+        propScaleY = createFloatProperty("sy", &store->sy[storeIndex]);
 
-        propRotateX = createFloatProperty("rx");
-        propRotateY = createFloatProperty("ry");
-        propRotateZ = createFloatProperty("rz");
+        propRotateX = createFloatProperty("rx", &store->rx[storeIndex]);
+        propRotateY = createFloatProperty("ry", &store->ry[storeIndex]);
+        propRotateZ = createFloatProperty("rz", &store->rz[storeIndex]);
 
-        propOpacity = createFloatProperty("opacity");
-        propVisible = createBooleanProperty("visible");
+        propOpacity = createFloatProperty("opacity", &store->opacity[storeIndex]);
+        propVisible = createBooleanProperty("visible", &store->visible[storeIndex]);
     }
 
     /**
@@ -298,14 +478,125 @@ public:
             return;
         }
 
-        AminoJSObject::destroy();
+        //instance
+        destroyAminoNode();
 
-        //to be overwritten
+        //base class
+        AminoJSObject::destroy();
 
         //debug
         //printf("Destroyed node: %i\n", type);
     }
 
+    /**
+     * Free instance resources.
+     */
+    void destroyAminoNode() {
+        //return storage slot
+        if (storeSlot != -1 && eventHandler) {
+            (static_cast<AminoGfx *>(eventHandler))->freeNodeSlot(storeSlot);
+            storeSlot = -1;
+        }
+    }
+
+    /**
+     * Get the opacity (from the dense storage).
+     */
+    GLfloat getOpacity() {
+        return store->opacity[storeIndex];
+    }
+
+    /**
+     * Check visibility (from the dense storage).
+     */
+    bool isVisible() {
+        return store->visible[storeIndex];
+    }
+
+    /**
+     * Handle async property updates.
+     */
+    void handleAsyncUpdate(AsyncPropertyUpdate *update) override {
+        //default: set value
+        AminoJSObject::handleAsyncUpdate(update);
+
+        //re-record
+        propertyChanged(update->property);
+    }
+
+    /**
+     * Handle a modified property value.
+     *
+     * Note: has to be called on the rendering thread.
+     */
+    void propertyChanged(AnyProperty *property) {
+        if (isTransformProperty(property)) {
+            localDirty = true;
+        } else if (property != propOpacity) {
+            //content changed
+            layerDirty = true;
+        }
+
+        invalidateRender();
+    }
+
+    /**
+     * Check if a property affects the local matrix.
+     */
+    bool isTransformProperty(AnyProperty *property) {
+        if (property == propX || property == propY || property == propZ ||
+            property == propScaleX || property == propScaleY ||
+            property == propRotateX || property == propRotateY || property == propRotateZ) {
+            return true;
+        }
+
+        //origin
+        if (propW && (property == propW || property == propH || property == propOriginX || property == propOriginY)) {
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Update the local matrix if a transform property changed.
+     */
+    void updateLocalMatrix() {
+        if (!localDirty) {
+            return;
+        }
+
+        GLfloat ox = 0;
+        GLfloat oy = 0;
+
+        if (propW) {
+            ox = propW->value * propOriginX->value;
+            oy = propH->value * propOriginY->value;
+        }
+
+        int i = storeIndex;
+
+        make_node_matrix(store->x[i], store->y[i], store->z[i], store->sx[i], store->sy[i], store->rx[i], store->ry[i], store->rz[i], ox, oy, localMatrix);
+        localAffine = store->z[i] == 0 && store->rx[i] == 0 && store->ry[i] == 0;
+
+        localDirty = false;
+    }
+
+    /**
+     * Mark the node's render commands as outdated.
+     *
+     * Note: has to be called on the rendering thread.
+     */
+    void invalidateRender() {
+        renderDirty = true;
+
+        //mark path to root
+        for (AminoNode *node = parent; node; node = node->parent) {
+            node->renderChildDirty = true;
+            node->layerDirty = true;
+        }
+    }
+
     /**
      * Get AminoGfx instance.
      */
@@ -339,6 +630,37 @@ public:
     }
 };
 
+/**
+ * Text glyphs stored on the same atlas page (one draw call).
+ */
+typedef struct {
+    amino_atlas_page_t *page;
+    GLuint textureId;
+
+    //indices
+    size_t start;
+    size_t count;
+} text_atlas_range_t;
+
+/**
+ * Text layout (created on rendering thread, executed on worker thread).
+ */
+typedef struct {
+    //input
+    AminoFontSize *fontSize;
+    std::string text;
+    int wrap;
+    int width;
+    int maxLines;
+
+    //result
+    vertex_buffer_t *buffer;
+    std::vector<text_atlas_range_t> ranges;
+    int lineNr;
+    float lineW;
+    bool glyphsChanged;
+} text_layout_t;
+
 /**
  * Text factory.
  */
@@ -354,6 +676,8 @@ public:
  */
 class AminoText : public AminoNode {
 public:
+    AMINO_SLAB_ALLOCATED(AminoText)
+
     //text
     Utf8Property *propText;
 
@@ -373,6 +697,7 @@ public:
     ObjectProperty *propFont;
     AminoFontSize *fontSize = NULL;
     vertex_buffer_t *buffer = NULL;
+    std::vector<text_atlas_range_t> atlasRanges;
 
     //alignment
     Utf8Property *propAlign;
@@ -385,9 +710,9 @@ public:
     int lineNr = 1;
     float lineW = 0;
 
-    //mutex
-    static uv_mutex_t freeTypeMutex;
-    static bool freeTypeMutexInitialized;
+    //layout (rendering thread)
+    bool layoutPending = false;
+    bool layoutDirty = false;
 
     //constants
     static const int ALIGN_LEFT   = 0x0;
@@ -404,8 +729,7 @@ public:
     static const int WRAP_WORD = 0x2;
 
     AminoText(): AminoNode(getFactory()->name, TEXT) {
-        //mutex
-        initFreeTypeMutex();
+        //empty
     }
 
     ~AminoText() {
@@ -414,19 +738,6 @@ public:
         }
     }
 
-    /**
-     * Initialize the mutex.
-     */
-    static void initFreeTypeMutex() {
-        if (!freeTypeMutexInitialized) {
-            freeTypeMutexInitialized = true;
-
-            int res = uv_mutex_init(&freeTypeMutex);
-
-            assert(res == 0);
-        }
-    }
-
     /**
      * Free all resources.
      */
@@ -464,11 +775,13 @@ public:
             }
         }
 
+        //atlas pages
+        releaseAtlasRanges();
+
         //release object values
         propFont->destroy();
 
         fontSize = NULL;
-        texture.textureId = INVALID_TEXTURE;
     }
 
     /**
@@ -534,7 +847,7 @@ public:
         //printf("AminoText::handleAsyncUpdate()\n");
 
         //default: set value
-        AminoJSObject::handleAsyncUpdate(update);
+        AminoNode::handleAsyncUpdate(update);
 
         //check font updates
         AnyProperty *property = update->property;
@@ -614,7 +927,7 @@ public:
 
             //new font
             fontSize = fs;
-            texture.textureId = INVALID_TEXTURE; //reset texture
+            releaseAtlasRanges(); //hide until layout is ready
 
             //debug
             //printf("-> use font: %s\n", fs->font->fontName.c_str());
@@ -630,21 +943,17 @@ public:
     /**
      * Update the rendered text.
      */
-    bool layoutText();
+    void startLayout();
+    static void layoutText(text_layout_t *layout);
+    void layoutDone(text_layout_t *layout);
 
     /**
-     * Create or update a font texture.
+     * Update a font texture.
      */
-    void updateTexture();
-    static void updateTextureFromAtlas(GLuint textureId, texture_atlas_t *atlas);
-
-    /**
-     * Get font texture.
-     */
-    GLuint getTextureId();
+    static void updateTextureFromAtlas(GLuint textureId, amino_atlas_page_t *page);
 
 private:
-    amino_atlas_t texture = { INVALID_TEXTURE };
+    void releaseAtlasRanges();
 
     /**
      * JS object construction.
@@ -653,7 +962,16 @@ private:
         AminoJSObject::createInstance(info, getFactory());
     }
 
-    static void addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, const char *text, vec2 *pen, int wrap, int width, int *lineNr, int maxLines, float *lineW);
+    void layoutReadyHandler(JSCallbackUpdate *update);
+    void layoutDoneHandler(AsyncValueUpdate *update, int state);
+    void applyLayout(text_layout_t *layout);
+    static void deleteLayout(text_layout_t *layout);
+
+    static void addTextGlyphs(vertex_buffer_t *buffer, texture_font_t *font, const char *text, vec2 *pen, int wrap, int width, int *lineNr, int maxLines, float *lineW, std::vector<texture_atlas_t *> *atlases = NULL);
+    static void groupGlyphsByAtlas(text_layout_t *layout, std::vector<texture_atlas_t *> &atlases);
+
+    //benchmarks
+    friend class AminoBench;
 };
 
 /**
@@ -670,6 +988,9 @@ public:
  * Animation class.
  */
 class AminoAnim : public AminoJSObject {
+public:
+    AMINO_SLAB_ALLOCATED(AminoAnim)
+
 private:
     AnyProperty *prop;
 
@@ -697,6 +1018,7 @@ private:
     double startTime = 0;
     double lastTime  = 0;
     double pauseTime = 0;
+    bool timerStarted = false;
 
     static const int FORWARD  = 1;
     static const int BACKWARD = 2;
@@ -905,6 +1227,17 @@ public:
 
         //start
         started = true;
+
+        if (eventHandler) {
+            (static_cast<AminoGfx *>(eventHandler))->wakeUp();
+        }
+    }
+
+    /**
+     * Check if the animation changes values.
+     */
+    bool isActive() {
+        return started && !ended;
     }
 
     /**
@@ -988,6 +1321,9 @@ public:
         FloatProperty *floatProp = static_cast<FloatProperty *>(prop);
 
         floatProp->setValue(value);
+
+        //re-record node
+        static_cast<AminoNode *>(prop->obj)->propertyChanged(prop);
     }
 
     //TODO pause
@@ -1086,10 +1422,11 @@ public:
         }
 
         //handle first start
-        if (startTime == 0) {
+        if (!timerStarted) {
             startTime = currentTime;
             lastTime = currentTime;
             pauseTime = 0;
+            timerStarted = true;
 
             //sync with reference time
             if (hasRefTime) {
@@ -1099,6 +1436,7 @@ public:
                     //in future: wait
                     startTime = 0;
                     lastTime = 0;
+                    timerStarted = false;
                     return;
                 }
 
@@ -1228,6 +1566,8 @@ private:
  */
 class AminoRect : public AminoNode {
 public:
+    AMINO_SLAB_ALLOCATED(AminoRect)
+
     bool hasImage;
 
     //color (no texture)
@@ -1388,7 +1728,7 @@ public:
      */
     void handleAsyncUpdate(AsyncPropertyUpdate *update) override {
         //default: set value
-        AminoJSObject::handleAsyncUpdate(update);
+        AminoNode::handleAsyncUpdate(update);
 
         //check property updates
         AnyProperty *property = update->property;
@@ -1430,11 +1770,18 @@ public:
     AminoJSObject* create() override;
 };
 
+typedef struct {
+    std::size_t offset;
+    std::vector<float> *values;
+} polygon_range_t;
+
 /**
  * AminoPolygon node class.
  */
 class AminoPolygon : public AminoNode {
 public:
+    AMINO_SLAB_ALLOCATED(AminoPolygon)
+
     //fill
     FloatProperty *propFillR;
     FloatProperty *propFillG;
@@ -1447,11 +1794,54 @@ public:
     //points
     FloatArrayProperty *propGeometry;
 
+    //VBO
+    GLuint vboGeometry = INVALID_BUFFER;
+    bool vboGeometryModified = true;
+    GLsizeiptr vboGeometrySize = 0;
+
+    //modified range (partial updates)
+    std::size_t geometryRangeStart = 0;
+    std::size_t geometryRangeEnd = 0;
+
+    //local bounds (cached)
+    GLfloat bounds[6];
+    bool hasBounds = false;
+    bool boundsModified = true;
+
     AminoPolygon(): AminoNode(getFactory()->name, POLY) {
         //empty
     }
 
     ~AminoPolygon() {
+        if (!destroyed) {
+            destroyAminoPolygon();
+        }
+    }
+
+    /**
+     * Free all resources.
+     */
+    void destroy() override {
+        if (destroyed) {
+            return;
+        }
+
+        //instance
+        destroyAminoPolygon();
+
+        //base class
+        AminoNode::destroy();
+    }
+
+    /**
+     * Free instance resources.
+     */
+    void destroyAminoPolygon() {
+        //free buffer
+        if (eventHandler && vboGeometry != INVALID_BUFFER) {
+            (static_cast<AminoGfx *>(eventHandler))->deleteBufferAsync(vboGeometry);
+            vboGeometry = INVALID_BUFFER;
+        }
     }
 
     void setup() override {
@@ -1489,7 +1879,8 @@ public:
     static v8::Local<v8::FunctionTemplate> GetInitFunction() {
         v8::Local<v8::FunctionTemplate> tpl = AminoJSObject::createTemplate(getFactory());
 
-        //no methods
+        //methods
+        Nan::SetPrototypeMethod(tpl, "_setGeometryRange", SetGeometryRange);
 
         //template function
         return tpl;
@@ -1501,6 +1892,117 @@ public:
     static NAN_METHOD(New) {
         AminoJSObject::createInstance(info, getFactory());
     }
+
+    /*
+     * Handle async property updates.
+     */
+    void handleAsyncUpdate(AsyncPropertyUpdate *update) override {
+        //default: set value
+        AminoNode::handleAsyncUpdate(update);
+
+        //check array updates
+        if (update->property == propGeometry) {
+            vboGeometryModified = true;
+            boundsModified = true;
+        } else if (update->property == propDimension) {
+            boundsModified = true;
+        }
+    }
+
+    /**
+     * Update a range of the geometry.
+     *
+     * Note: only the new values are copied and uploaded.
+     */
+    static NAN_METHOD(SetGeometryRange) {
+        if (info.Length() != 2) {
+            Nan::ThrowTypeError("expected offset and values");
+            return;
+        }
+
+        if (!info[0]->IsNumber()) {
+            Nan::ThrowTypeError("expected numeric offset");
+            return;
+        }
+
+        AminoPolygon *polygon = Nan::ObjectWrap::Unwrap<AminoPolygon>(info.This());
+        int offset = info[0]->Int32Value();
+        v8::Local<v8::Value> value = info[1];
+
+        assert(polygon);
+
+        if (offset < 0) {
+            Nan::ThrowRangeError("invalid offset");
+            return;
+        }
+
+        //copy values
+        bool valid = false;
+        std::vector<float> *values = (std::vector<float> *)polygon->propGeometry->getAsyncData(value, valid);
+
+        if (!valid) {
+            Nan::ThrowTypeError("expected Float32Array or array");
+            return;
+        }
+
+        if (values->empty()) {
+            delete values;
+            return;
+        }
+
+        //handle async
+        polygon_range_t *data = new polygon_range_t();
+
+        data->offset = offset;
+        data->values = values;
+
+        polygon->enqueueValueUpdate(value, data, static_cast<asyncValueCallback>(&AminoPolygon::updateGeometryRange));
+    }
+
+    /**
+     * Apply a geometry range update.
+     */
+    void updateGeometryRange(AsyncValueUpdate *update, int state) {
+        if (state == AsyncValueUpdate::STATE_APPLY) {
+            polygon_range_t *data = (polygon_range_t *)update->data;
+
+            assert(data);
+
+            std::vector<float> &geometry = propGeometry->value;
+            std::size_t start = data->offset;
+            std::size_t end = start + data->values->size();
+
+            if (end > geometry.size()) {
+                //grows: full upload
+                geometry.resize(end);
+                vboGeometryModified = true;
+            }
+
+            std::copy(data->values->begin(), data->values->end(), geometry.begin() + start);
+            boundsModified = true;
+
+            //extend modified range
+            if (geometryRangeStart == geometryRangeEnd) {
+                geometryRangeStart = start;
+                geometryRangeEnd = end;
+            } else {
+                geometryRangeStart = std::min(geometryRangeStart, start);
+                geometryRangeEnd = std::max(geometryRangeEnd, end);
+            }
+
+            propertyChanged(propGeometry);
+        } else if (state == AsyncValueUpdate::STATE_DELETE) {
+            //on main thread
+            polygon_range_t *data = (polygon_range_t *)update->data;
+
+            assert(data);
+
+            //free
+            delete data->values;
+            delete data;
+            update->data = NULL;
+        }
+    }
 };
 
 /**
@@ -1518,6 +2020,8 @@ public:
  */
 class AminoModel : public AminoNode {
 public:
+    AMINO_SLAB_ALLOCATED(AminoModel)
+
     //fill
     FloatProperty *propFillR;
     FloatProperty *propFillG;
@@ -1543,6 +2047,16 @@ public:
     bool vboUVModified = true;
     bool vboIndexModified = true;
 
+    GLsizeiptr vboVertexSize = 0;
+    GLsizeiptr vboNormalSize = 0;
+    GLsizeiptr vboUVSize = 0;
+    GLsizeiptr vboIndexSize = 0;
+
+    //local bounds (cached)
+    GLfloat bounds[6];
+    bool hasBounds = false;
+    bool boundsModified = true;
+
     AminoModel(): AminoNode(getFactory()->name, MODEL) {
         //empty
     }
@@ -1584,6 +2098,11 @@ public:
                 vboNormal = INVALID_BUFFER;
             }
 
+            if (vboUV != INVALID_BUFFER) {
+                (static_cast<AminoGfx *>(eventHandler))->deleteBufferAsync(vboUV);
+                vboUV = INVALID_BUFFER;
+            }
+
             if (vboIndex != INVALID_BUFFER) {
                 (static_cast<AminoGfx *>(eventHandler))->deleteBufferAsync(vboIndex);
                 vboIndex = INVALID_BUFFER;
@@ -1655,7 +2174,7 @@ public:
      */
     void handleAsyncUpdate(AsyncPropertyUpdate *update) override {
         //default: set value
-        AminoJSObject::handleAsyncUpdate(update);
+        AminoNode::handleAsyncUpdate(update);
 
         //check array updates
         AnyProperty *property = update->property;
@@ -1664,6 +2183,7 @@ public:
 
         if (property == propVertices) {
             vboVertexModified = true;
+            boundsModified = true;
         } else if (property == propNormals) {
             vboNormalModified = true;
         } else if (property == propUVs) {
@@ -1698,12 +2218,15 @@ typedef struct {
  */
 class AminoGroup : public AminoNode {
 public:
+    AMINO_SLAB_ALLOCATED(AminoGroup)
+
     //internal
     std::vector<AminoNode *> children;
 
     //properties
     BooleanProperty *propClipRect;
     BooleanProperty *propDepth;
+    BooleanProperty *propCache;
 
     AminoGroup(): AminoNode(getFactory()->name, GROUP) {
         //empty
@@ -1736,6 +2259,24 @@ public:
     void destroyAminoGroup() {
         //reset children
         children.clear();
+
+        //free cached layer
+        if (eventHandler) {
+            (static_cast<AminoGfx *>(eventHandler))->deleteLayerAsync(this);
+        }
+    }
+
+    /**
+     * Handle async property updates.
+     */
+    void handleAsyncUpdate(AsyncPropertyUpdate *update) override {
+        //default: set value
+        AminoNode::handleAsyncUpdate(update);
+
+        //no longer cached
+        if (update->property == propCache && !propCache->value) {
+            getAminoGfx()->freeLayer(this);
+        }
     }
 
     void setup() override {
@@ -1750,6 +2291,7 @@ public:
 
         propClipRect = createBooleanProperty("clipRect");
         propDepth = createBooleanProperty("depth");
+        propCache = createBooleanProperty("cache");
     }
 
     //creation
@@ -1828,6 +2370,11 @@ private:
 
         children.push_back(node);
 
+        node->parent = this;
+        node->worldValid = false;
+        layerDirty = true;
+        invalidateRender();
+
         //debug (provoke crash to get stack trace)
         if (DEBUG_CRASH) {
             int *foo = (int *)1;
@@ -1881,6 +2428,11 @@ private:
             }
 
             children.insert(children.begin() + data->pos, data->child);
+
+            data->child->parent = this;
+            data->child->worldValid = false;
+            layerDirty = true;
+            invalidateRender();
         } else if (state == AsyncValueUpdate::STATE_DELETE) {
             //on main thread
             group_insert_t *data = (group_insert_t *)update->data;
@@ -1929,6 +2481,11 @@ private:
         assert(pos != children.end());
 
         children.erase(pos);
+
+        node->parent = NULL;
+        node->worldValid = false;
+        layerDirty = true;
+        invalidateRender();
     }
 };
 
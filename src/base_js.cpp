@@ -1,6 +1,7 @@
 #include "base_js.h"
 
 #include <sstream>
+#include <algorithm>
 
 #define DEBUG_ASYNC false
 #define DEBUG_JS_INSTANCES false
@@ -25,6 +26,104 @@ AminoJSObject* AminoJSObjectFactory::create() {
     return NULL;
 }
 
+//
+//  AminoSlab
+//
+
+/**
+ * Create slab allocator.
+ */
+AminoSlab::AminoSlab(std::string name, std::size_t size): name(name) {
+    //keep alignment
+    std::size_t align = sizeof(double) * 2;
+
+    this->size = (std::max(size, sizeof(void *)) + align - 1) / align * align;
+
+    getInstances().push_back(this);
+}
+
+/**
+ * Allocate an instance.
+ */
+void* AminoSlab::alloc(std::size_t size) {
+    if (size > this->size) {
+        //larger subclass
+        return ::operator new(size);
+    }
+
+    if (!freeList) {
+        //new slab
+        char *slab = (char *)::operator new(this->size * SLAB_OBJECTS);
+
+        slabs.push_back(slab);
+
+        for (int i = SLAB_OBJECTS - 1; i >= 0; i--) {
+            void *p = slab + i * this->size;
+
+            *static_cast<void **>(p) = freeList;
+            freeList = p;
+        }
+
+        freeCount += SLAB_OBJECTS;
+    }
+
+    void *p = freeList;
+
+    freeList = *static_cast<void **>(p);
+    freeCount--;
+    liveCount++;
+
+    return p;
+}
+
+/**
+ * Return an instance.
+ */
+void AminoSlab::free(void *p, std::size_t size) {
+    if (!p) {
+        return;
+    }
+
+    if (size > this->size) {
+        ::operator delete(p);
+        return;
+    }
+
+    *static_cast<void **>(p) = freeList;
+    freeList = p;
+    freeCount++;
+    liveCount--;
+}
+
+/**
+ * Get all slab allocators.
+ */
+std::vector<AminoSlab *>& AminoSlab::getInstances() {
+    static std::vector<AminoSlab *> instances;
+
+    return instances;
+}
+
+/**
+ * Add live and free slots of each class.
+ */
+void AminoSlab::getStats(v8::Local<v8::Object> &obj) {
+    std::vector<AminoSlab *> &instances = getInstances();
+    v8::Local<v8::Object> slabsObj = Nan::New<v8::Object>();
+
+    for (std::size_t i = 0; i < instances.size(); i++) {
+        AminoSlab *slab = instances[i];
+        v8::Local<v8::Object> slabObj = Nan::New<v8::Object>();
+
+        Nan::Set(slabObj, Nan::New("live").ToLocalChecked(), Nan::New(slab->liveCount));
+        Nan::Set(slabObj, Nan::New("free").ToLocalChecked(), Nan::New(slab->freeCount));
+        Nan::Set(slabObj, Nan::New("slabs").ToLocalChecked(), Nan::New((uint32_t)slab->slabs.size()));
+        Nan::Set(slabsObj, Nan::New(slab->name).ToLocalChecked(), slabObj);
+    }
+
+    Nan::Set(obj, Nan::New("slabs").ToLocalChecked(), slabsObj);
+}
+
 //
 //  AminoJSObject
 //
@@ -60,14 +159,14 @@ AminoJSObject::~AminoJSObject() {
     }
 
     //free properties
-    for (std::map<int, AnyProperty *>::iterator iter = propertyMap.begin(); iter != propertyMap.end(); iter++) {
-        delete iter->second;
+    for (std::size_t i = 0; i < properties.size(); i++) {
+        delete properties[i];
     }
 
     //debug
-    //printf("deleted %i properties\n", (int)propertyMap.size());
+    //printf("deleted %i properties\n", (int)properties.size());
 
-    propertyMap.clear();
+    properties.clear();
 
     //instance count
     activeInstances--;
@@ -199,6 +298,8 @@ void AminoJSObject::createInstance(Nan::NAN_METHOD_ARGS_TYPE info, AminoJSObject
 
     assert(obj);
 
+    obj->factory = factory;
+
     //bind to C++ instance
     obj->Wrap(info.This());
 
@@ -315,11 +416,11 @@ Nan::Persistent<v8::Function>* AminoJSObject::propertyUpdatedFunc = NULL;
 /**
  * Create float property (bound to JS property).
  *
- * Note: has to be called in JS scope of setup()!
+ * Note: has to be called in JS scope of setup()! The value is kept in storage if set.
  */
-AminoJSObject::FloatProperty* AminoJSObject::createFloatProperty(std::string name) {
+AminoJSObject::FloatProperty* AminoJSObject::createFloatProperty(std::string name, float *storage) {
     int id = ++lastPropertyId;
-    FloatProperty *prop = new FloatProperty(this, name, id);
+    FloatProperty *prop = new FloatProperty(this, name, id, storage);
 
     addProperty(prop);
 
@@ -385,11 +486,11 @@ AminoJSObject::UInt32Property* AminoJSObject::createUInt32Property(std::string n
 /**
  * Create boolean property (bound to JS property).
  *
- * Note: has to be called in JS scope of setup()!
+ * Note: has to be called in JS scope of setup()! The value is kept in storage if set.
  */
-AminoJSObject::BooleanProperty* AminoJSObject::createBooleanProperty(std::string name) {
+AminoJSObject::BooleanProperty* AminoJSObject::createBooleanProperty(std::string name, bool *storage) {
     int id = ++lastPropertyId;
-    BooleanProperty *prop = new BooleanProperty(this, name, id);
+    BooleanProperty *prop = new BooleanProperty(this, name, id, storage);
 
     addProperty(prop);
 
@@ -438,7 +539,18 @@ void AminoJSObject::addProperty(AnyProperty *prop) {
 
     int id = prop->id;
 
-    propertyMap[id] = prop;
+    assert(id > 0);
+
+    if ((int)properties.size() < id) {
+        properties.resize(id, NULL);
+    }
+
+    properties[id - 1] = prop;
+
+    //shared name table (keeps first id)
+    if (factory) {
+        factory->propertyIds.insert(std::make_pair(prop->name, id));
+    }
 
     v8::Local<v8::Value> value;
 
@@ -693,23 +805,37 @@ bool AminoJSObject::enqueueJSCallbackUpdate(jsUpdateCallback callbackApply, jsUp
  * Get property with id.
  */
 AminoJSObject::AnyProperty* AminoJSObject::getPropertyWithId(int id) {
-    std::map<int, AnyProperty *>::iterator iter = propertyMap.find(id);
-
-    if (iter == propertyMap.end()) {
+    if (id <= 0 || id > (int)properties.size()) {
         //property not found
         return NULL;
     }
 
-    return iter->second;
+    return properties[id - 1];
 }
 
 /**
  * Get property with name.
  */
 AminoJSObject::AnyProperty* AminoJSObject::getPropertyWithName(std::string name) {
-    for (std::map<int, AnyProperty *>::iterator iter = propertyMap.begin(); iter != propertyMap.end(); iter++) {
-        if (iter->second->name == name) {
-            return iter->second;
+    //shared table
+    if (factory) {
+        std::unordered_map<std::string, int>::iterator iter = factory->propertyIds.find(name);
+
+        if (iter != factory->propertyIds.end()) {
+            AnyProperty *prop = getPropertyWithId(iter->second);
+
+            if (prop && prop->name == name) {
+                return prop;
+            }
+        }
+    }
+
+    //search
+    for (std::size_t i = 0; i < properties.size(); i++) {
+        AnyProperty *prop = properties[i];
+
+        if (prop && prop->name == name) {
+            return prop;
         }
     }
 
@@ -861,7 +987,7 @@ void AminoJSObject::AnyProperty::release() {
 /**
  * FloatProperty constructor.
  */
-AminoJSObject::FloatProperty::FloatProperty(AminoJSObject *obj, std::string name, int id): AnyProperty(PROPERTY_FLOAT, obj, name, id) {
+AminoJSObject::FloatProperty::FloatProperty(AminoJSObject *obj, std::string name, int id, float *storage): AnyProperty(PROPERTY_FLOAT, obj, name, id), value(storage ? *storage:localValue) {
     //empty
 }
 
@@ -1034,16 +1160,14 @@ void* AminoJSObject::FloatArrayProperty::getAsyncData(v8::Local<v8::Value> &valu
         //Float32Array
         v8::Handle<v8::Float32Array> arr = v8::Handle<v8::Float32Array>::Cast(value);
         v8::ArrayBuffer::Contents contents = arr->Buffer()->GetContents();
-        float *data = (float *)contents.Data();
-        std::size_t count = contents.ByteLength() / sizeof(float);
+        float *data = (float *)((char *)contents.Data() + arr->ByteOffset());
+        std::size_t count = arr->Length();
 
         //debug
         //printf("is Float32Array (size: %i)\n", (int)count);
 
-        //copy to vector
-        vector = new std::vector<float>();
-
-        vector->assign(data, data + count);
+        //copy to vector (single copy of the view's range; the render thread takes it over)
+        vector = new std::vector<float>(data, data + count);
 
         valid = true;
     } else if (value->IsArray()) {
@@ -1051,6 +1175,7 @@ void* AminoJSObject::FloatArrayProperty::getAsyncData(v8::Local<v8::Value> &valu
         std::size_t count = arr->Length();
 
         vector = new std::vector<float>();
+        vector->reserve(count);
 
         for (std::size_t i = 0; i < count; i++) {
             vector->push_back((float)(arr->Get(i)->NumberValue()));
@@ -1073,7 +1198,8 @@ void AminoJSObject::FloatArrayProperty::setAsyncData(AsyncPropertyUpdate *update
         return;
     }
 
-    value = *((std::vector<float> *)data);
+    //take over buffer (old value gets freed with the update on the main thread)
+    value.swap(*((std::vector<float> *)data));
 }
 
 /**
@@ -1176,16 +1302,14 @@ void* AminoJSObject::UShortArrayProperty::getAsyncData(v8::Local<v8::Value> &val
         //Uint16Array
         v8::Handle<v8::Uint16Array> arr = v8::Handle<v8::Uint16Array>::Cast(value);
         v8::ArrayBuffer::Contents contents = arr->Buffer()->GetContents();
-        ushort *data = (ushort *)contents.Data();
-        std::size_t count = contents.ByteLength() / sizeof(ushort);
+        ushort *data = (ushort *)((char *)contents.Data() + arr->ByteOffset());
+        std::size_t count = arr->Length();
 
         //debug
         //printf("is Float32Array (size: %i)\n", (int)count);
 
-        //copy to vector
-        vector = new std::vector<ushort>();
-
-        vector->assign(data, data + count);
+        //copy to vector (single copy of the view's range; the render thread takes it over)
+        vector = new std::vector<ushort>(data, data + count);
 
         valid = true;
     } else if (value->IsArray()) {
@@ -1193,6 +1317,7 @@ void* AminoJSObject::UShortArrayProperty::getAsyncData(v8::Local<v8::Value> &val
         std::size_t count = arr->Length();
 
         vector = new std::vector<ushort>();
+        vector->reserve(count);
 
         for (std::size_t i = 0; i < count; i++) {
             vector->push_back((ushort)(arr->Get(i)->Uint32Value()));
@@ -1215,7 +1340,8 @@ void AminoJSObject::UShortArrayProperty::setAsyncData(AsyncPropertyUpdate *updat
         return;
     }
 
-    value = *((std::vector<ushort> *)data);
+    //take over buffer (old value gets freed with the update on the main thread)
+    value.swap(*((std::vector<ushort> *)data));
 }
 
 /**
@@ -1412,7 +1538,7 @@ void AminoJSObject::UInt32Property::freeAsyncData(void *data) {
 /**
  * BooleanProperty constructor.
  */
-AminoJSObject::BooleanProperty::BooleanProperty(AminoJSObject *obj, std::string name, int id): AnyProperty(PROPERTY_BOOLEAN, obj, name, id) {
+AminoJSObject::BooleanProperty::BooleanProperty(AminoJSObject *obj, std::string name, int id, bool *storage): AnyProperty(PROPERTY_BOOLEAN, obj, name, id), value(storage ? *storage:localValue) {
     //empty
 }
 
@@ -1851,8 +1977,7 @@ void AminoJSObject::JSCallbackUpdate::apply() {
 // AminoJSEventObject
 //
 
-AminoJSEventObject::AminoJSEventObject(std::string name): AminoJSObject(name) {
-    asyncUpdates = new std::vector<AnyAsyncUpdate *>();
+AminoJSEventObject::AminoJSEventObject(std::string name): AminoJSObject(name), asyncUpdates(NULL), asyncQueueSize(0) {
     asyncDeletes = new std::vector<AnyAsyncUpdate *>();
     jsUpdates = new std::vector<AnyAsyncUpdate *>();
 
@@ -1883,7 +2008,6 @@ AminoJSEventObject::~AminoJSEventObject() {
 
     //asyncUpdates
     clearAsyncQueue();
-    delete asyncUpdates;
 
     //asyncDeletes
     handleAsyncDeletes();
@@ -1908,25 +2032,66 @@ AminoJSEventObject* AminoJSEventObject::getEventHandler() {
  * Note: items are never applied.
  */
 void AminoJSEventObject::clearAsyncQueue() {
-    assert(asyncUpdates);
+    AnyAsyncUpdate *item = takeAsyncUpdates();
 
-    int res = pthread_mutex_lock(&asyncLock);
+    while (item) {
+        AnyAsyncUpdate *next = item->next;
 
-    assert(res == 0);
+        delete item;
+        item = next;
+    }
+}
 
-    std::size_t count = asyncUpdates->size();
+/**
+ * Add an update to the async queue.
+ *
+ * Note: lock-free, called on any thread.
+ */
+void AminoJSEventObject::pushAsyncUpdate(AnyAsyncUpdate *update) {
+    update->queueTime = uv_hrtime();
 
-    for (std::size_t i = 0; i < count; i++) {
-        AnyAsyncUpdate *item = (*asyncUpdates)[i];
+    pushAsyncUpdates(update, update, 1);
+}
 
-        delete item;
+/**
+ * Add a chain of updates to the async queue.
+ *
+ * Note: the chain is linked from the newest (first) to the oldest (last) update. Lock-free, called on any thread.
+ */
+void AminoJSEventObject::pushAsyncUpdates(AnyAsyncUpdate *first, AnyAsyncUpdate *last, int count) {
+    AnyAsyncUpdate *head = asyncUpdates.load(std::memory_order_relaxed);
+
+    do {
+        last->next = head;
+    } while (!asyncUpdates.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+
+    asyncQueueSize += count;
+}
+
+/**
+ * Take all queued updates (in order of arrival).
+ *
+ * Note: lock-free, single consumer.
+ */
+AminoJSObject::AnyAsyncUpdate* AminoJSEventObject::takeAsyncUpdates() {
+    AnyAsyncUpdate *item = asyncUpdates.exchange(NULL, std::memory_order_acquire);
+
+    //reverse (newest item first)
+    AnyAsyncUpdate *list = NULL;
+    int count = 0;
+
+    while (item) {
+        AnyAsyncUpdate *next = item->next;
+
+        item->next = list;
+        list = item;
+        item = next;
+        count++;
     }
 
-    //Note: not applied, can safely clear vector
-    asyncUpdates->clear();
+    asyncQueueSize -= count;
 
-    res = pthread_mutex_unlock(&asyncLock);
-    assert(res == 0);
+    return list;
 }
 
 /**
@@ -2011,10 +2176,20 @@ void AminoJSEventObject::getStats(v8::Local<v8::Object> &obj) {
 
     /*
     Nan::Set(obj, Nan::New("jsUpdates").ToLocalChecked(), Nan::New<v8::Uint32>((uint32_t)jsUpdates->size()));
-    Nan::Set(obj, Nan::New("asyncUpdates").ToLocalChecked(), Nan::New<v8::Uint32>((uint32_t)asyncUpdates->size()));
     Nan::Set(obj, Nan::New("asyncDeletes").ToLocalChecked(), Nan::New<v8::Uint32>((uint32_t)asyncDeletes->size()));
     */
 
+    //async queue (latency in milliseconds)
+    Nan::Set(obj, Nan::New("asyncQueueDepth").ToLocalChecked(), Nan::New((int)asyncQueueSize));
+    Nan::Set(obj, Nan::New("asyncQueueProcessed").ToLocalChecked(), Nan::New(lastAsyncQueueSize));
+    Nan::Set(obj, Nan::New("asyncQueueMaxDepth").ToLocalChecked(), Nan::New(maxAsyncQueueSize));
+    Nan::Set(obj, Nan::New("asyncLatency").ToLocalChecked(), Nan::New(lastAsyncLatency));
+    Nan::Set(obj, Nan::New("asyncMaxLatency").ToLocalChecked(), Nan::New(maxAsyncLatency));
+    Nan::Set(obj, Nan::New("coalescedUpdates").ToLocalChecked(), Nan::New(coalescedUpdates));
+
+    //allocators
+    AminoSlab::getStats(obj);
+
     //output instance stats
     if (DEBUG_JS_INSTANCES) {
         //collect items
@@ -2076,72 +2251,128 @@ void AminoJSEventObject::processAsyncQueue() {
         printf("--- processAsyncQueue() --- \n");
     }
 
-    //iterate
-    assert(asyncUpdates);
+    //take snapshots until empty (handlers can add updates)
+    AnyAsyncUpdate *done = NULL;
+    AnyAsyncUpdate *doneLast = NULL;
+    int count = 0;
+    double latency = 0;
+    AnyAsyncUpdate *item;
 
-    int res = pthread_mutex_lock(&asyncLock);
+    while ((item = takeAsyncUpdates()) != NULL) {
+        uint64_t now = uv_hrtime();
 
-    assert(res == 0);
+        //find the last value of each property (last writer wins)
+        for (AnyAsyncUpdate *update = item; update; update = update->next) {
+            if (update->type == ASYNC_UPDATE_PROPERTY) {
+                AsyncPropertyUpdate *propItem = static_cast<AsyncPropertyUpdate *>(update);
 
-    for (std::size_t i = 0; i < asyncUpdates->size(); i++) {
-        AnyAsyncUpdate *item = (*asyncUpdates)[i];
+                propItem->property->lastUpdate = propItem;
+            }
+        }
 
-        assert(item);
+        while (item) {
+            AnyAsyncUpdate *next = item->next;
 
-        //debug
-        //printf("%i of %i (type: %i)\n", (int)i, (int)asyncUpdates->size(), (int)item->type);
+            //stats
+            double itemLatency = (now - item->queueTime) / 1e6;
 
-        switch (item->type) {
-            case ASYNC_UPDATE_PROPERTY:
-                //property update
-                {
-                    AsyncPropertyUpdate *propItem = static_cast<AsyncPropertyUpdate *>(item);
+            if (itemLatency > latency) {
+                latency = itemLatency;
+            }
 
-                    //call local handler
-                    assert(propItem->property);
-                    assert(propItem->property->obj);
+            //debug
+            //printf("%i (type: %i)\n", count, (int)item->type);
 
-                    if (DEBUG_ASYNC) {
-                        printf("%i of %i (property: %s of %s)\n", (int)i, (int)asyncUpdates->size(), propItem->property->name.c_str(), propItem->property->obj->getName().c_str());
-                    }
+            switch (item->type) {
+                case ASYNC_UPDATE_PROPERTY:
+                    //property update
+                    {
+                        AsyncPropertyUpdate *propItem = static_cast<AsyncPropertyUpdate *>(item);
+
+                        //skip outdated values
+                        if (propItem->property->lastUpdate != propItem) {
+                            coalescedUpdates++;
+                            break;
+                        }
 
-                    propItem->property->obj->handleAsyncUpdate(propItem);
-                }
-                break;
+                        propItem->property->lastUpdate = NULL;
 
-            case ASYNC_UPDATE_VALUE:
-                //custom value update
-                {
-                    AsyncValueUpdate *valueItem = static_cast<AsyncValueUpdate *>(item);
+                        //call local handler
+                        assert(propItem->property);
+                        assert(propItem->property->obj);
 
-                    //call local handler
-                    assert(valueItem->obj);
+                        if (DEBUG_ASYNC) {
+                            printf("%i (property: %s of %s)\n", count, propItem->property->name.c_str(), propItem->property->obj->getName().c_str());
+                        }
 
-                    if (DEBUG_ASYNC) {
-                        printf("%i of %i (type: value update)\n", (int)i, (int)asyncUpdates->size());
+                        propItem->property->obj->handleAsyncUpdate(propItem);
                     }
+                    break;
+
+                case ASYNC_UPDATE_VALUE:
+                    //custom value update
+                    {
+                        AsyncValueUpdate *valueItem = static_cast<AsyncValueUpdate *>(item);
+
+                        //call local handler
+                        assert(valueItem->obj);
 
-                    if (!valueItem->obj->handleAsyncUpdate(valueItem)) {
-                        printf("unhandled async update by %s\n", valueItem->obj->getName().c_str());
+                        if (DEBUG_ASYNC) {
+                            printf("%i (type: value update)\n", count);
+                        }
+
+                        if (!valueItem->obj->handleAsyncUpdate(valueItem)) {
+                            printf("unhandled async update by %s\n", valueItem->obj->getName().c_str());
+                        }
                     }
-                }
-                break;
+                    break;
+
+                default:
+                    printf("unknown async type: %i\n", item->type);
+                    assert(false);
+                    break;
+            }
 
-            default:
-                printf("unknown async type: %i\n", item->type);
-                assert(false);
-                break;
+            //keep order
+            item->next = NULL;
+
+            if (doneLast) {
+                doneLast->next = item;
+            } else {
+                done = item;
+            }
+
+            doneLast = item;
+            count++;
+            item = next;
         }
+    }
+
+    //free items on main thread
+    if (done) {
+        int res = pthread_mutex_lock(&asyncLock);
 
-        //free item
-        asyncDeletes->push_back(item);
+        assert(res == 0);
+
+        for (item = done; item; item = item->next) {
+            asyncDeletes->push_back(item);
+        }
+
+        res = pthread_mutex_unlock(&asyncLock);
+        assert(res == 0);
     }
 
-    //clear
-    asyncUpdates->clear();
+    //stats
+    lastAsyncQueueSize = count;
+    lastAsyncLatency = latency;
 
-    res = pthread_mutex_unlock(&asyncLock);
-    assert(res == 0);
+    if (count > maxAsyncQueueSize) {
+        maxAsyncQueueSize = count;
+    }
+
+    if (latency > maxAsyncLatency) {
+        maxAsyncLatency = latency;
+    }
 
     if (DEBUG_BASE) {
         printf("--- processAsyncQueue() done --- \n");
@@ -2166,16 +2397,8 @@ bool AminoJSEventObject::enqueueValueUpdate(AsyncValueUpdate *update) {
         printf("enqueueValueUpdate\n");
     }
 
-    assert(asyncUpdates);
-
-    int res = pthread_mutex_lock(&asyncLock);
-
-    assert(res == 0);
-
-    asyncUpdates->push_back(update);
-
-    res = pthread_mutex_unlock(&asyncLock);
-    assert(res == 0);
+    pushAsyncUpdate(update);
+    asyncUpdateAdded();
 
     return true;
 }
@@ -2214,16 +2437,83 @@ bool AminoJSEventObject::enqueuePropertyUpdate(AnyProperty *prop, v8::Local<v8::
     }
 
     //async handling
-    int res = pthread_mutex_lock(&asyncLock);
+    pushAsyncUpdate(new AsyncPropertyUpdate(prop, data));
+    asyncUpdateAdded();
 
-    assert(res == 0);
+    return true;
+}
 
-    asyncUpdates->push_back(new AsyncPropertyUpdate(prop, data));
+/**
+ * Enqueue numeric updates of many properties at once.
+ *
+ * Note: has to be called on main thread. Returns the number of queued updates.
+ */
+int AminoJSEventObject::enqueuePropertyUpdates(std::vector<AnyProperty *> &props, float *values) {
+    if (destroyed) {
+        return 0;
+    }
 
-    res = pthread_mutex_unlock(&asyncLock);
-    assert(res == 0);
+    //create chain (newest first)
+    AnyAsyncUpdate *first = NULL;
+    AnyAsyncUpdate *last = NULL;
+    int count = 0;
+    uint64_t now = uv_hrtime();
+    std::size_t size = props.size();
 
-    return true;
+    for (std::size_t i = 0; i < size; i++) {
+        AnyProperty *prop = props[i];
+
+        assert(prop);
+        assert(prop->type == PROPERTY_FLOAT);
+
+        float *data = new float;
+
+        *data = values[i];
+
+        //call sync handler
+        assert(prop->obj);
+
+        if (prop->obj->handleSyncUpdate(prop, data)) {
+            prop->freeAsyncData(data);
+            continue;
+        }
+
+        //async handling
+        AsyncPropertyUpdate *update = new AsyncPropertyUpdate(prop, data);
+
+        update->queueTime = now;
+        update->next = first;
+        first = update;
+
+        if (!last) {
+            last = update;
+        }
+
+        count++;
+    }
+
+    if (count > 0) {
+        pushAsyncUpdates(first, last, count);
+        asyncUpdateAdded();
+    }
+
+    return count;
+}
+
+/**
+ * Check if async updates are waiting.
+ */
+bool AminoJSEventObject::hasAsyncUpdates() {
+    return asyncUpdates.load(std::memory_order_relaxed) != NULL;
+}
+
+/**
+ * An async update was added to the queue.
+ *
+ * Note: called on any thread.
+ */
+void AminoJSEventObject::asyncUpdateAdded() {
+    //empty: overwrite
 }
 
 /**
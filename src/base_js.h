@@ -6,7 +6,9 @@
 #include <nan.h>
 
 #include <map>
+#include <unordered_map>
 #include <memory>
+#include <atomic>
 #include <pthread.h>
 
 #define ASYNC_UPDATE_PROPERTY      0
@@ -15,6 +17,9 @@
 #define ASYNC_JS_UPDATE_CALLBACK  11
 #define ASYNC_UPDATE_CUSTOM      100
 
+//objects per slab (see AminoSlab)
+#define SLAB_OBJECTS 64
+
 #define DEBUG_BASE false
 
 #define DEBUG_THREADS false
@@ -23,6 +28,47 @@
 
 class AminoJSObject;
 
+/**
+ * Slab allocator for instances of a single class.
+ *
+ * Note: main thread only. Slabs are kept for reuse.
+ */
+class AminoSlab {
+public:
+    AminoSlab(std::string name, std::size_t size);
+
+    void* alloc(std::size_t size);
+    void free(void *p, std::size_t size);
+
+    static void getStats(v8::Local<v8::Object> &obj);
+
+private:
+    std::string name;
+    std::size_t size;
+
+    void *freeList = NULL;
+    std::vector<void *> slabs;
+    int liveCount = 0;
+    int freeCount = 0;
+
+    static std::vector<AminoSlab *>& getInstances();
+};
+
+/**
+ * Allocate class instances from a slab.
+ */
+#define AMINO_SLAB_ALLOCATED(CLASS) \
+    static AminoSlab& getSlab() { \
+        static AminoSlab slab(#CLASS, sizeof(CLASS)); \
+        return slab; \
+    } \
+    static void* operator new(std::size_t size) { \
+        return getSlab().alloc(size); \
+    } \
+    static void operator delete(void *p, std::size_t size) { \
+        getSlab().free(p, size); \
+    }
+
 /**
  * Factory object to create JS instance.
  */
@@ -31,6 +77,9 @@ public:
     std::string name;
     Nan::FunctionCallback callback;
 
+    //property ids (same in all instances)
+    std::unordered_map<std::string, int> propertyIds;
+
     AminoJSObjectFactory(std::string name, Nan::FunctionCallback callback);
 
     virtual AminoJSObject* create();
@@ -46,6 +95,7 @@ class AminoJSEventObject;
 class AminoJSObject : public Nan::ObjectWrap {
 protected:
     std::string name;
+    AminoJSObjectFactory *factory = NULL;
     AminoJSEventObject *eventHandler = NULL;
     bool destroyed = false;
 
@@ -87,6 +137,9 @@ protected:
         int id;
         bool connected = false;
 
+        //newest queued update (rendering thread)
+        AsyncPropertyUpdate *lastUpdate = NULL;
+
         AnyProperty(int type, AminoJSObject *obj, std::string name, int id);
         virtual ~AnyProperty();
 
@@ -106,10 +159,16 @@ protected:
     };
 
     class FloatProperty : public AnyProperty {
+    private:
+        //own storage (if not stored externally)
+        float localValue = 0;
+
     public:
-        float value = 0;
+        AMINO_SLAB_ALLOCATED(FloatProperty)
+
+        float &value;
 
-        FloatProperty(AminoJSObject *obj, std::string name, int id);
+        FloatProperty(AminoJSObject *obj, std::string name, int id, float *storage = NULL);
         ~FloatProperty();
 
         void setValue(float newValue);
@@ -127,6 +186,8 @@ protected:
 
     class FloatArrayProperty : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(FloatArrayProperty)
+
         std::vector<float> value;
 
         FloatArrayProperty(AminoJSObject *obj, std::string name, int id);
@@ -147,6 +208,8 @@ protected:
 
     class UShortArrayProperty : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(UShortArrayProperty)
+
         std::vector<ushort> value;
 
         UShortArrayProperty(AminoJSObject *obj, std::string name, int id);
@@ -167,6 +230,8 @@ protected:
 
     class Int32Property : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(Int32Property)
+
         int value = 0;
 
         Int32Property(AminoJSObject *obj, std::string name, int id);
@@ -187,6 +252,8 @@ protected:
 
     class UInt32Property : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(UInt32Property)
+
         unsigned int value = 0;
 
         UInt32Property(AminoJSObject *obj, std::string name, int id);
@@ -206,10 +273,16 @@ protected:
     };
 
     class BooleanProperty : public AnyProperty {
+    private:
+        //own storage (if not stored externally)
+        bool localValue = false;
+
     public:
-        bool value = false;
+        AMINO_SLAB_ALLOCATED(BooleanProperty)
 
-        BooleanProperty(AminoJSObject *obj, std::string name, int id);
+        bool &value;
+
+        BooleanProperty(AminoJSObject *obj, std::string name, int id, bool *storage = NULL);
         ~BooleanProperty();
 
         void setValue(bool newValue);
@@ -227,6 +300,8 @@ protected:
 
     class Utf8Property : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(Utf8Property)
+
         std::string value;
 
         Utf8Property(AminoJSObject *obj, std::string name, int id);
@@ -248,6 +323,8 @@ protected:
 
     class ObjectProperty : public AnyProperty {
     public:
+        AMINO_SLAB_ALLOCATED(ObjectProperty)
+
         AminoJSObject *value = NULL;
 
         ObjectProperty(AminoJSObject *obj, std::string name, int id);
@@ -270,12 +347,12 @@ protected:
 
     void updateProperty(AnyProperty *property);
 
-    FloatProperty* createFloatProperty(std::string name);
+    FloatProperty* createFloatProperty(std::string name, float *storage = NULL);
     FloatArrayProperty* createFloatArrayProperty(std::string name);
     UShortArrayProperty* createUShortArrayProperty(std::string name);
     Int32Property* createInt32Property(std::string name);
     UInt32Property* createUInt32Property(std::string name);
-    BooleanProperty* createBooleanProperty(std::string name);
+    BooleanProperty* createBooleanProperty(std::string name, bool *storage = NULL);
     Utf8Property* createUtf8Property(std::string name);
     ObjectProperty* createObjectProperty(std::string name);
 
@@ -288,6 +365,10 @@ protected:
     public:
         int type;
 
+        //async queue (see AminoJSEventObject)
+        AnyAsyncUpdate *next = NULL;
+        uint64_t queueTime = 0;
+
         AnyAsyncUpdate(int type);
         virtual ~AnyAsyncUpdate();
 
@@ -296,6 +377,8 @@ protected:
 
     class AsyncPropertyUpdate : public AnyAsyncUpdate {
     public:
+        AMINO_SLAB_ALLOCATED(AsyncPropertyUpdate)
+
         AnyProperty *property;
         void *data;
 
@@ -380,7 +463,7 @@ protected:
 private:
     //properties
     int lastPropertyId = 0;
-    std::map<int, AnyProperty *> propertyMap;
+    std::vector<AnyProperty *> properties; //index: id - 1
 
     bool addPropertyWatcher(std::string name, int id, v8::Local<v8::Value> &jsValue);
     void addProperty(AnyProperty *prop);
@@ -421,6 +504,7 @@ public:
     AminoJSEventObject* getEventHandler() override;
 
     bool enqueuePropertyUpdate(AnyProperty *prop, v8::Local<v8::Value> &value);
+    int enqueuePropertyUpdates(std::vector<AnyProperty *> &props, float *values);
     bool enqueueValueUpdate(AsyncValueUpdate *update) override;
 
     bool enqueueJSPropertyUpdate(AnyProperty *prop) override;
@@ -431,6 +515,8 @@ public:
 protected:
     bool isEventHandler() override;
     void processAsyncQueue();
+    bool hasAsyncUpdates();
+    virtual void asyncUpdateAdded();
     void clearAsyncQueue();
     void handleAsyncDeletes();
     void handleJSUpdates();
@@ -438,12 +524,26 @@ protected:
     virtual void getStats(v8::Local<v8::Object> &obj);
 
 private:
-    std::vector<AnyAsyncUpdate *> *asyncUpdates = NULL;
+    //lock-free queue (multiple producers, rendering thread consumes)
+    std::atomic<AnyAsyncUpdate *> asyncUpdates;
+    std::atomic<int> asyncQueueSize;
+
     std::vector<AnyAsyncUpdate *> *asyncDeletes = NULL;
     std::vector<AnyAsyncUpdate *> *jsUpdates = NULL;
 
     uv_thread_t mainThread;
-    pthread_mutex_t asyncLock; //Note: can block for a while
+    pthread_mutex_t asyncLock; //Note: asyncDeletes and jsUpdates only
+
+    //async queue stats
+    int coalescedUpdates = 0;
+    int lastAsyncQueueSize = 0;
+    int maxAsyncQueueSize = 0;
+    double lastAsyncLatency = 0;
+    double maxAsyncLatency = 0;
+
+    void pushAsyncUpdate(AnyAsyncUpdate *update);
+    void pushAsyncUpdates(AnyAsyncUpdate *first, AnyAsyncUpdate *last, int count);
+    AnyAsyncUpdate* takeAsyncUpdates();
 };
 
 #endif
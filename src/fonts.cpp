@@ -80,13 +80,22 @@ AminoJSObject* AminoFontsFactory::create() {
 //
 
 AminoFont::AminoFont(): AminoJSObject(getFactory()->name) {
-    //empty
+    //mutex
+    int res = uv_mutex_init(&freeTypeMutex);
+
+    assert(res == 0);
+
+    instances.push_back(this);
 }
 
 AminoFont::~AminoFont() {
     if (!destroyed) {
         destroyAminoFont();
     }
+
+    uv_mutex_destroy(&freeTypeMutex);
+
+    instances.erase(std::remove(instances.begin(), instances.end(), this), instances.end());
 }
 
 /**
@@ -108,6 +117,9 @@ void AminoFont::destroy() {
  * Destroy font data.
  */
 void AminoFont::destroyAminoFont() {
+    //wait for running layouts
+    lock();
+
     //font sizes
     for (std::map<int, texture_font_t *>::iterator it = fontSizes.begin(); it != fontSizes.end(); it++) {
         texture_font_delete(it->second);
@@ -115,12 +127,23 @@ void AminoFont::destroyAminoFont() {
 
     fontSizes.clear();
 
-    //atlas
-    if (atlas) {
-        texture_atlas_delete(atlas);
-        atlas = NULL;
+    //FreeType
+    if (library) {
+        FT_Done_FreeType(library);
+        library = NULL;
+    }
+
+    //atlas pages
+    for (auto const &page : atlasPages) {
+        texture_atlas_delete(page->atlas);
+        delete page;
     }
 
+    atlasPages.clear();
+    atlas = NULL;
+
+    unlock();
+
     //font data
     fontData.Reset();
 }
@@ -175,24 +198,36 @@ void AminoFont::preInit(Nan::NAN_METHOD_ARGS_TYPE info) {
 
     this->fontData.Reset(bufferObj);
 
-    //create atlas
-    atlas = texture_atlas_new(512, 512, 1); //depth must be 1
+    //create atlas (first page)
+    amino_atlas_page_t *page = newAtlasPage(ATLAS_PAGE_SIZE);
 
-    if (!atlas) {
+    if (!page) {
         Nan::ThrowTypeError("could not create atlas");
         return;
     }
 
+    atlas = page->atlas;
+
+    //FreeType instance
+    if (FT_Init_FreeType(&library)) {
+        library = NULL;
+
+        Nan::ThrowTypeError("could not init FreeType");
+        return;
+    }
+
     //metadata
     v8::Local<v8::Value> nameValue = Nan::Get(fontData, Nan::New<v8::String>("name").ToLocalChecked()).ToLocalChecked();
     v8::Local<v8::Value> styleValue = Nan::Get(fontData, Nan::New<v8::String>("style").ToLocalChecked()).ToLocalChecked();
+    v8::Local<v8::Value> sdfValue = Nan::Get(fontData, Nan::New<v8::String>("sdf").ToLocalChecked()).ToLocalChecked();
 
     fontName = AminoJSObject::toString(nameValue);
     fontWeight = Nan::Get(fontData, Nan::New<v8::String>("weight").ToLocalChecked()).ToLocalChecked()->NumberValue();
     fontStyle = AminoJSObject::toString(styleValue);
+    sdf = sdfValue->IsBoolean() && sdfValue->BooleanValue();
 
     if (DEBUG_FONTS) {
-        printf("-> new font: name=%s, style=%s, weight=%i\n", fontName.c_str(), fontStyle.c_str(), fontWeight);
+        printf("-> new font: name=%s, style=%s, weight=%i, sdf=%i\n", fontName.c_str(), fontStyle.c_str(), fontWeight, sdf);
     }
 }
 
@@ -202,7 +237,14 @@ void AminoFont::preInit(Nan::NAN_METHOD_ARGS_TYPE info) {
  * Note: has to be called in v8 thread.
  */
 texture_font_t *AminoFont::getFontWithSize(int size) {
-    //check cache
+    //SDF: shared by all sizes
+    if (sdf) {
+        size = SDF_FONT_SIZE;
+    }
+
+    //check cache (Note: sizes are modified by layouts on worker threads)
+    lock();
+
     std::map<int, texture_font_t *>::iterator it = fontSizes.find(size);
     texture_font_t *fontSize;
 
@@ -216,10 +258,14 @@ texture_font_t *AminoFont::getFontWithSize(int size) {
         fontSize = texture_font_new_from_memory(atlas, size, buffer, bufferLen, library);
 
         if (fontSize) {
-            fontSizes[size] = fontSize;
+            if (sdf) {
+                //distance field glyphs (scaled, no hinting)
+                fontSize->rendermode = RENDER_SIGNED_DISTANCE_FIELD;
+                fontSize->padding = SDF_SPREAD;
+                fontSize->hinting = 0;
+            }
 
-            //use single FreeType instance
-            library = fontSize->library;
+            fontSizes[size] = fontSize;
         }
 
         if (DEBUG_FONTS) {
@@ -229,6 +275,8 @@ texture_font_t *AminoFont::getFontWithSize(int size) {
         fontSize = it->second;
     }
 
+    unlock();
+
     return fontSize;
 }
 
@@ -239,7 +287,175 @@ std::string AminoFont::getFontInfo() {
     return fontName + "/" + fontStyle + "/" + std::to_string(fontWeight);
 }
 
-FT_Library AminoFont::library = NULL;
+/**
+ * Lock glyph access (FreeType and atlas).
+ */
+void AminoFont::lock() {
+    uv_mutex_lock(&freeTypeMutex);
+}
+
+/**
+ * Unlock glyph access.
+ */
+void AminoFont::unlock() {
+    uv_mutex_unlock(&freeTypeMutex);
+}
+
+/**
+ * Create a new atlas page.
+ */
+amino_atlas_page_t *AminoFont::newAtlasPage(size_t size) {
+    texture_atlas_t *atlas = texture_atlas_new(size, size, 1); //depth must be 1
+
+    if (!atlas) {
+        return NULL;
+    }
+
+    amino_atlas_page_t *page = new amino_atlas_page_t();
+
+    page->atlas = atlas;
+    page->font = this;
+    page->users = 0;
+    page->lastUsed = ++atlasTick;
+
+    atlasPages.push_back(page);
+
+    return page;
+}
+
+/**
+ * Switch to the next atlas page (current page is full).
+ *
+ * Adds a larger page or evicts the glyphs of the least recently used page no text is using.
+ *
+ * Note: font has to be locked.
+ */
+bool AminoFont::nextAtlasPage() {
+    amino_atlas_page_t *page = NULL;
+
+    //grow
+    if (atlasPages.size() < ATLAS_MAX_PAGES) {
+        size_t size = std::min(atlasPages.back()->atlas->width * 2, (size_t)ATLAS_PAGE_MAX_SIZE);
+
+        page = newAtlasPage(size);
+    }
+
+    //evict
+    if (!page) {
+        for (auto const &item : atlasPages) {
+            if (item->atlas == atlas || item->users > 0) {
+                continue;
+            }
+
+            if (!page || item->lastUsed < page->lastUsed) {
+                page = item;
+            }
+        }
+
+        if (!page) {
+            //all pages in use
+            return false;
+        }
+
+        for (auto const &item : fontSizes) {
+            texture_font_remove_glyphs(item.second, page->atlas);
+        }
+
+        texture_atlas_clear(page->atlas);
+        evictions++;
+    }
+
+    if (DEBUG_FONTS) {
+        printf("-> atlas page: %i (%s)\n", (int)page->atlas->width, getFontInfo().c_str());
+    }
+
+    //use for all sizes
+    atlas = page->atlas;
+    page->lastUsed = ++atlasTick;
+
+    for (auto const &item : fontSizes) {
+        item.second->atlas = atlas;
+        item.second->atlas_full = 0;
+    }
+
+    return true;
+}
+
+/**
+ * Get the page of an atlas.
+ *
+ * Note: font has to be locked.
+ */
+amino_atlas_page_t *AminoFont::getAtlasPage(texture_atlas_t *atlas) {
+    for (auto const &page : atlasPages) {
+        if (page->atlas == atlas) {
+            return page;
+        }
+    }
+
+    assert(false);
+
+    return NULL;
+}
+
+/**
+ * Mark an atlas page as used by a text.
+ *
+ * Note: font has to be locked.
+ */
+amino_atlas_page_t *AminoFont::acquireAtlasPage(texture_atlas_t *atlas) {
+    amino_atlas_page_t *page = getAtlasPage(atlas);
+
+    if (page) {
+        page->users++;
+        page->lastUsed = ++atlasTick;
+    }
+
+    return page;
+}
+
+/**
+ * Text no longer uses the atlas page.
+ *
+ * Note: lock free (called on rendering thread).
+ */
+void AminoFont::releaseAtlasPage(amino_atlas_page_t *page) {
+    assert(page->users > 0);
+
+    page->users--;
+}
+
+/**
+ * Get atlas statistics of all fonts.
+ */
+void AminoFont::getStats(v8::Local<v8::Object> &obj) {
+    size_t pages = 0;
+    size_t used = 0;
+    size_t size = 0;
+    unsigned int evictions = 0;
+
+    for (auto const &font : instances) {
+        font->lock();
+
+        for (auto const &page : font->atlasPages) {
+            used += page->atlas->used;
+            size += page->atlas->width * page->atlas->height * page->atlas->depth;
+        }
+
+        pages += font->atlasPages.size();
+        evictions += font->evictions;
+
+        font->unlock();
+    }
+
+    Nan::Set(obj, Nan::New("atlasPages").ToLocalChecked(), Nan::New((double)pages));
+    Nan::Set(obj, Nan::New("atlasMemory").ToLocalChecked(), Nan::New((double)size));
+    Nan::Set(obj, Nan::New("atlasUsage").ToLocalChecked(), Nan::New(size > 0 ? used / (double)size:0));
+    Nan::Set(obj, Nan::New("atlasEvictions").ToLocalChecked(), Nan::New(evictions));
+}
+
+//static initializers
+std::vector<AminoFont *> AminoFont::instances;
 
 //
 //  AminoFontFactory
@@ -321,8 +537,11 @@ void AminoFontSize::preInit(Nan::NAN_METHOD_ARGS_TYPE info) {
 
     if (!fontTexture) {
         Nan::ThrowTypeError("could not create font size");
+        return;
     }
 
+    scale = size / fontTexture->size;
+
     //font properties
     v8::Local<v8::Object> obj = handle();
 
@@ -351,47 +570,72 @@ NAN_METHOD(AminoFontSize::CalcTextWidth) {
  */
 float AminoFontSize::getTextWidth(const char *text) {
     size_t len = utf8_strlen(text);
-    char *textPos = (char *)text;
-    char *lastTextPos = NULL;
+    std::vector<amino_atlas_page_t *> pages;
     float w = 0;
 
-    AminoText::initFreeTypeMutex();
-    uv_mutex_lock(&AminoText::freeTypeMutex);
+    font->lock();
 
     size_t lastGlyphCount = fontTexture->glyphs->size;
+    int pass;
 
-    for (std::size_t i = 0; i < len; i++) {
-        texture_glyph_t *glyph = texture_font_get_glyph(fontTexture, textPos);
+    for (pass = 0; ; pass++) {
+        char *textPos = (char *)text;
+        texture_glyph_t *lastGlyph = NULL;
 
-        if (!glyph) {
-            printf("Error: got empty glyph from texture_font_get_glyph()\n");
-            continue;
-        }
+        w = 0;
+        pages.clear();
+        fontTexture->atlas_full = 0;
 
-        //kerning
-        if (lastTextPos) {
-            w += texture_glyph_get_kerning(glyph, lastTextPos);
-        }
+        for (std::size_t i = 0; i < len; i++) {
+            texture_glyph_t *glyph = texture_font_get_glyph(fontTexture, textPos);
+            size_t charLen = utf8_surrogate_len(textPos);
+
+            if (!glyph) {
+                if (!fontTexture->atlas_full) {
+                    printf("Error: got empty glyph from texture_font_get_glyph()\n");
+                }
+
+                textPos += charLen;
+                continue;
+            }
+
+            //kerning
+            if (lastGlyph) {
+                w += texture_font_get_kerning(fontTexture, lastGlyph, glyph);
+            }
 
-        //char width
-        w += glyph->advance_x;
+            //char width
+            w += glyph->advance_x;
 
-        //next
-        size_t charLen = utf8_surrogate_len(textPos);
+            //pages to update
+            amino_atlas_page_t *page = font->getAtlasPage(glyph->atlas);
 
-        lastTextPos = textPos;
-        textPos += charLen;
+            if (std::find(pages.begin(), pages.end(), page) == pages.end()) {
+                pages.push_back(page);
+            }
+
+            //next
+            lastGlyph = glyph;
+            textPos += charLen;
+        }
+
+        //retry on next atlas page (previous glyphs might have been evicted)
+        if (!fontTexture->atlas_full || pass + 1 >= ATLAS_MAX_PAGES || !font->nextAtlasPage()) {
+            break;
+        }
     }
 
-    bool glyphsChanged = lastGlyphCount != fontTexture->glyphs->size;
+    bool glyphsChanged = lastGlyphCount != fontTexture->glyphs->size || pass > 0;
 
-    uv_mutex_unlock(&AminoText::freeTypeMutex);
+    font->unlock();
 
-    if (glyphsChanged) {
-        texture_atlas_t *atlas = fontTexture->atlas;
+    w *= scale;
 
+    if (glyphsChanged) {
         //update all instances
-        AminoGfx::updateAtlasTextures(atlas);
+        for (auto const &page : pages) {
+            AminoGfx::updateAtlasTextures(page);
+        }
     }
 
     return w;
@@ -408,9 +652,9 @@ NAN_METHOD(AminoFontSize::GetFontMetrics) {
     //metrics
     v8::Local<v8::Object> metricsObj = Nan::New<v8::Object>();
 
-    Nan::Set(metricsObj, Nan::New("height").ToLocalChecked(), Nan::New<v8::Number>(obj->fontTexture->ascender - obj->fontTexture->descender));
-    Nan::Set(metricsObj, Nan::New("ascender").ToLocalChecked(), Nan::New<v8::Number>(obj->fontTexture->ascender));
-    Nan::Set(metricsObj, Nan::New("descender").ToLocalChecked(), Nan::New<v8::Number>(obj->fontTexture->descender));
+    Nan::Set(metricsObj, Nan::New("height").ToLocalChecked(), Nan::New<v8::Number>((obj->fontTexture->ascender - obj->fontTexture->descender) * obj->scale));
+    Nan::Set(metricsObj, Nan::New("ascender").ToLocalChecked(), Nan::New<v8::Number>(obj->fontTexture->ascender * obj->scale));
+    Nan::Set(metricsObj, Nan::New("descender").ToLocalChecked(), Nan::New<v8::Number>(obj->fontTexture->descender * obj->scale));
 
     info.GetReturnValue().Set(metricsObj);
 }
@@ -531,3 +775,49 @@ amino_atlas_t AminoFontShader::getAtlasTexture(texture_atlas_t *atlas, bool crea
 
     return it->second;
 }
+
+//
+// AminoSdfFontShader
+//
+
+AminoSdfFontShader::AminoSdfFontShader() : AminoFontShader() {
+    //shader
+
+    //Note: distance 0.5 is the glyph outline
+    fragmentShader = R"(
+        #ifdef GL_ES
+            precision mediump float;
+        #endif
+
+        uniform float opacity;
+        uniform vec3 color;
+        uniform float smoothing;
+        uniform sampler2D tex;
+
+        varying vec2 uv;
+
+        void main() {
+            float d = texture2D(tex, uv).a;
+            float a = smoothstep(0.5 - smoothing, 0.5 + smoothing, d);
+
+            gl_FragColor = vec4(color, opacity * a);
+        }
+    )";
+}
+
+/**
+ * Initialize the SDF font shader.
+ */
+void AminoSdfFontShader::initShader() {
+    AminoFontShader::initShader();
+
+    //uniforms
+    uSmoothing = getUniformLocation("smoothing");
+}
+
+/**
+ * Set edge smoothing (distance range of one pixel on screen).
+ */
+void AminoSdfFontShader::setSmoothing(GLfloat smoothing) {
+    glUniform1f(uSmoothing, smoothing);
+}
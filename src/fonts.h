@@ -5,11 +5,22 @@
 #include "vertex-buffer.h"
 
 #include <map>
+#include <vector>
+#include <atomic>
 
 #include "base_js.h"
 #include "gfx.h"
 #include "shaders.h"
 
+//glyph atlas pages (per font)
+#define ATLAS_PAGE_SIZE     512
+#define ATLAS_PAGE_MAX_SIZE 2048
+#define ATLAS_MAX_PAGES     4
+
+//signed distance field fonts (one glyph set for all sizes)
+#define SDF_FONT_SIZE 48
+#define SDF_SPREAD    6
+
 class AminoFontsFactory;
 
 /**
@@ -42,6 +53,23 @@ public:
 };
 
 class AminoFontFactory;
+class AminoFont;
+
+/**
+ * Glyph atlas page (shared by all sizes of a font).
+ */
+typedef struct {
+    texture_atlas_t *atlas;
+
+    //owner (lock while accessing atlas data)
+    AminoFont *font;
+
+    //texts using the page (page is not evicted while in use)
+    std::atomic<int> users;
+
+    //LRU tick
+    unsigned int lastUsed;
+} amino_atlas_page_t;
 
 /**
  * AminoFont class.
@@ -51,6 +79,7 @@ public:
     std::string fontName;
     int fontWeight;
     std::string fontStyle;
+    bool sdf = false;
 
     AminoFont();
     ~AminoFont();
@@ -58,6 +87,18 @@ public:
     texture_font_t *getFontWithSize(int size);
     std::string getFontInfo();
 
+    void lock();
+    void unlock();
+
+    //atlas pages (font has to be locked)
+    bool nextAtlasPage();
+    amino_atlas_page_t *getAtlasPage(texture_atlas_t *atlas);
+    amino_atlas_page_t *acquireAtlasPage(texture_atlas_t *atlas);
+    static void releaseAtlasPage(amino_atlas_page_t *page);
+
+    //stats
+    static void getStats(v8::Local<v8::Object> &obj);
+
     //creation
     static AminoFontFactory* getFactory();
 
@@ -65,8 +106,14 @@ public:
     static v8::Local<v8::FunctionTemplate> GetInitFunction();
 
 private:
-    //Note: instance kept
-    static FT_Library library;
+    //FreeType instance (shared by all sizes)
+    FT_Library library = NULL;
+    uv_mutex_t freeTypeMutex;
+
+    //all fonts (stats)
+    static std::vector<AminoFont *> instances;
+
+    amino_atlas_page_t *newAtlasPage(size_t size);
 
     //JS constructor
     static NAN_METHOD(New);
@@ -75,7 +122,10 @@ private:
 
 protected:
     AminoFonts *fonts = NULL;
-    texture_atlas_t *atlas = NULL;
+    texture_atlas_t *atlas = NULL; //current page
+    std::vector<amino_atlas_page_t *> atlasPages;
+    unsigned int atlasTick = 0;
+    unsigned int evictions = 0;
     Nan::Persistent<v8::Object> fontData;
     std::map<int, texture_font_t *> fontSizes;
 
@@ -103,6 +153,9 @@ public:
     texture_font_t *fontTexture = NULL;
     AminoFont *font = NULL;
 
+    //font size to glyph size (SDF font)
+    float scale = 1;
+
     AminoFontSize();
     ~AminoFontSize();
 
@@ -162,4 +215,19 @@ protected:
     void initShader() override;
 };
 
+/**
+ * Signed distance field font shader.
+ */
+class AminoSdfFontShader : public AminoFontShader {
+public:
+    AminoSdfFontShader();
+
+    void setSmoothing(GLfloat smoothing);
+
+protected:
+    GLint uSmoothing;
+
+    void initShader() override;
+};
+
 #endif
\ No newline at end of file
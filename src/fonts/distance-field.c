@@ -35,10 +35,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include "edtaa3func.h"
+#include "distance-field.h"
 
 
 double *
 make_distance_mapd( double *data, unsigned int width, unsigned int height )
+{
+    return make_distance_mapd_spread( data, width, height, 0 );
+}
+
+double *
+make_distance_mapd_spread( double *data, unsigned int width, unsigned int height,
+                           double spread )
 {
     short * xdist = (short *)  malloc( width * height * sizeof(short) );
     short * ydist = (short *)  malloc( width * height * sizeof(short) );
@@ -77,6 +85,10 @@ make_distance_mapd( double *data, unsigned int width, unsigned int height )
 
     vmin = fabs(vmin);
 
+    // fixed range (same scale for all glyphs)
+    if( spread > 0 )
+        vmin = spread;
+
     for( i=0; i<width*height; ++i)
     {
         double v = outside[i];
@@ -97,6 +109,14 @@ make_distance_mapd( double *data, unsigned int width, unsigned int height )
 unsigned char *
 make_distance_mapb( unsigned char *img,
                     unsigned int width, unsigned int height )
+{
+    return make_distance_mapb_spread( img, width, height, 0 );
+}
+
+unsigned char *
+make_distance_mapb_spread( unsigned char *img,
+                           unsigned int width, unsigned int height,
+                           double spread )
 {
     double * data    = (double *) calloc( width * height, sizeof(double) );
     unsigned char *out = (unsigned char *) malloc( width * height * sizeof(unsigned char) );
@@ -120,7 +140,7 @@ make_distance_mapb( unsigned char *img,
     for( i=0; i<width*height; ++i)
         data[i] = (img[i]-img_min)/img_max;
 
-    data = make_distance_mapd(data, width, height);
+    data = make_distance_mapd_spread(data, width, height, spread);
 
     // map values from 0.0 - 1.0 to 0 - 255
     for( i=0; i<width*height; ++i)
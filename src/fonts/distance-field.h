@@ -85,6 +85,28 @@ unsigned char *
 make_distance_mapb( unsigned char *img,
                     unsigned int width, unsigned int height );
 
+/**
+ * Create a distance field with a fixed range.
+ *
+ * @param img     A greyscale image.
+ * @param width   The width of the given image.
+ * @param height  The height of the given image.
+ * @param spread  Distance (in pixels) mapped to 0 and 1 (0 for the
+ *                maximum inside distance of the image).
+ *
+ * @return        A newly allocated distance field.  This image must
+ *                be freed after usage.
+ */
+double *
+make_distance_mapd_spread( double *img,
+                           unsigned int width, unsigned int height,
+                           double spread );
+
+unsigned char *
+make_distance_mapb_spread( unsigned char *img,
+                           unsigned int width, unsigned int height,
+                           double spread );
+
 /** @} */
 
 #ifdef __cplusplus
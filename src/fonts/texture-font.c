@@ -207,7 +207,7 @@ texture_glyph_new(void)
     self->t0        = 0.0;
     self->s1        = 0.0;
     self->t1        = 0.0;
-    self->kerning   = vector_new( sizeof(kerning_t) );
+    self->atlas     = NULL;
     return self;
 }
 
@@ -217,67 +217,186 @@ void
 texture_glyph_delete( texture_glyph_t *self )
 {
     assert( self );
-    vector_delete( self->kerning );
     free( self );
 }
 
-// ---------------------------------------------- texture_glyph_get_kerning ---
-float
-texture_glyph_get_kerning( const texture_glyph_t * self,
-                           const char * codepoint )
+// ------------------------------------------------------ texture_font_hash ---
+static size_t
+texture_font_hash( uint32_t key, size_t size )
+{
+    key *= 2654435761u;
+
+    return (key ^ (key >> 16)) & (size - 1);
+}
+
+// --------------------------------------------- texture_font_rebuild_table ---
+static void
+texture_font_rebuild_table( texture_font_t * self )
 {
     size_t i;
-    uint32_t ucodepoint = utf8_to_utf32( codepoint );
+    size_t size = self->glyph_table_size;
+
+    memset( self->glyph_table, 0, size * sizeof(texture_glyph_t *) );
+
+    /* Re-add in load order (first match wins) */
+    for( i = 0; i < self->glyphs->size; ++i )
+    {
+        texture_glyph_t *item = *(texture_glyph_t **) vector_get( self->glyphs, i );
+        size_t pos = texture_font_hash( item->codepoint, size );
+
+        while( self->glyph_table[pos] )
+            pos = (pos + 1) & (size - 1);
+
+        self->glyph_table[pos] = item;
+    }
+}
+
+// ------------------------------------------------- texture_font_add_glyph ---
+static void
+texture_font_add_glyph( texture_font_t * self,
+                        texture_glyph_t * glyph )
+{
+    size_t i;
+
+    /* Grow table (load factor 0.5) */
+    if( (self->glyphs->size + 1) * 2 > self->glyph_table_size )
+    {
+        size_t size = self->glyph_table_size ? self->glyph_table_size * 2 : 256;
+
+        free( self->glyph_table );
+        self->glyph_table = malloc( size * sizeof(texture_glyph_t *) );
+        self->glyph_table_size = size;
+
+        texture_font_rebuild_table( self );
+    }
+
+    vector_push_back( self->glyphs, &glyph );
+
+    i = texture_font_hash( glyph->codepoint, self->glyph_table_size );
+
+    while( self->glyph_table[i] )
+        i = (i + 1) & (self->glyph_table_size - 1);
+
+    self->glyph_table[i] = glyph;
+}
+
+// -------------------------------------------- texture_font_remove_glyphs ---
+size_t
+texture_font_remove_glyphs( texture_font_t * self,
+                            const texture_atlas_t * atlas )
+{
+    size_t i, count = 0;
 
     assert( self );
-    for( i=0; i<vector_size(self->kerning); ++i )
+
+    /* Compact glyph list (keeps load order) */
+    for( i = 0; i < self->glyphs->size; ++i )
     {
-        kerning_t * kerning = (kerning_t *) vector_get( self->kerning, i );
-        if( kerning->codepoint == ucodepoint )
+        texture_glyph_t *glyph = *(texture_glyph_t **) vector_get( self->glyphs, i );
+
+        if( glyph->atlas == atlas )
         {
-            return kerning->kerning;
+            texture_glyph_delete( glyph );
+            count++;
+        }
+        else if( count )
+        {
+            vector_set( self->glyphs, i - count, &glyph );
         }
     }
-    return 0;
-}
 
+    if( !count )
+        return 0;
 
-// ------------------------------------------ texture_font_generate_kerning ---
-void
-texture_font_generate_kerning( texture_font_t *self)
+    vector_resize( self->glyphs, self->glyphs->size - count );
+
+    if( self->glyph_table_size )
+        texture_font_rebuild_table( self );
+
+    return count;
+}
+
+// ----------------------------------------------- texture_font_get_kerning ---
+float
+texture_font_get_kerning( texture_font_t * self,
+                          const texture_glyph_t * left,
+                          const texture_glyph_t * right )
 {
-    size_t i, j;
-    FT_UInt glyph_index, prev_index;
-    texture_glyph_t *glyph, *prev_glyph;
+    size_t i;
+    uint32_t key;
     FT_Vector kerning;
+    kerning_pair_t *pair;
 
     assert( self );
-    assert(self->library);
-    assert(self->face);
+    assert( left );
+    assert( right );
 
-    /* For each glyph couple combination, check if kerning is necessary */
-    /* Starts at index 1 since 0 is for the special background glyph */
-    for( i=1; i<self->glyphs->size; ++i )
+    if( !self->kerning || !self->face || !FT_HAS_KERNING( self->face ) )
+        return 0;
+
+    key = left->codepoint * 31 + right->codepoint;
+
+    /* Cached value */
+    if( self->kerning_table_size )
     {
-        glyph = *(texture_glyph_t **) vector_get( self->glyphs, i );
-        glyph_index = FT_Get_Char_Index( self->face, glyph->codepoint );
-        vector_clear( glyph->kerning );
+        i = texture_font_hash( key, self->kerning_table_size );
 
-        for( j=1; j<self->glyphs->size; ++j )
+        while( self->kerning_table[i].used )
         {
-            prev_glyph = *(texture_glyph_t **) vector_get( self->glyphs, j );
-            prev_index = FT_Get_Char_Index( self->face, prev_glyph->codepoint );
-            FT_Get_Kerning( self->face, prev_index, glyph_index, FT_KERNING_UNFITTED, &kerning );
-            // printf("%c(%d)-%c(%d): %ld\n",
-            //       prev_glyph->codepoint, prev_glyph->codepoint,
-            //       glyph_index, glyph_index, kerning.x);
-            if( kerning.x )
+            pair = &self->kerning_table[i];
+
+            if( pair->left == left->codepoint && pair->right == right->codepoint )
+                return pair->kerning;
+
+            i = (i + 1) & (self->kerning_table_size - 1);
+        }
+    }
+
+    /* Grow table (load factor 0.5) */
+    if( (self->kerning_table_count + 1) * 2 > self->kerning_table_size )
+    {
+        kerning_pair_t *old = self->kerning_table;
+        size_t old_size = self->kerning_table_size;
+        size_t size = old_size ? old_size * 2 : 256;
+
+        self->kerning_table = calloc( size, sizeof(kerning_pair_t) );
+        self->kerning_table_size = size;
+
+        for( i = 0; i < old_size; ++i )
+        {
+            if( old[i].used )
             {
-                kerning_t k = {prev_glyph->codepoint, kerning.x / (float)(HRESf*HRESf)};
-                vector_push_back( glyph->kerning, &k );
+                size_t pos = texture_font_hash( old[i].left * 31 + old[i].right, size );
+
+                while( self->kerning_table[pos].used )
+                    pos = (pos + 1) & (size - 1);
+
+                self->kerning_table[pos] = old[i];
             }
         }
+
+        free( old );
     }
+
+    /* Load pair */
+    FT_Get_Kerning( self->face,
+                    FT_Get_Char_Index( self->face, left->codepoint ),
+                    FT_Get_Char_Index( self->face, right->codepoint ),
+                    FT_KERNING_UNFITTED, &kerning );
+
+    i = texture_font_hash( key, self->kerning_table_size );
+
+    while( self->kerning_table[i].used )
+        i = (i + 1) & (self->kerning_table_size - 1);
+
+    pair = &self->kerning_table[i];
+    pair->left = left->codepoint;
+    pair->right = right->codepoint;
+    pair->kerning = kerning.x / (float)(HRESf*HRESf);
+    pair->used = 1;
+    self->kerning_table_count++;
+
+    return pair->kerning;
 }
 
 // ------------------------------------------------------ texture_font_init ---
@@ -445,6 +564,8 @@ texture_font_delete( texture_font_t *self )
     }
 
     vector_delete( self->glyphs );
+    free( self->glyph_table );
+    free( self->kerning_table );
     free( self );
 }
 
@@ -456,9 +577,13 @@ texture_font_find_glyph( texture_font_t * self,
     texture_glyph_t *glyph;
     uint32_t ucodepoint = utf8_to_utf32( codepoint );
 
-    for( i = 0; i < self->glyphs->size; ++i )
+    if( !self->glyph_table_size )
+        return NULL;
+
+    i = texture_font_hash( ucodepoint, self->glyph_table_size );
+
+    while( (glyph = self->glyph_table[i]) )
     {
-        glyph = *(texture_glyph_t **) vector_get( self->glyphs, i );
         // If codepoint is -1, we don't care about outline type or thickness
         if( (glyph->codepoint == ucodepoint) &&
             ((ucodepoint == UINT32_MAX) ||
@@ -467,6 +592,8 @@ texture_font_find_glyph( texture_font_t * self,
         {
             return glyph;
         }
+
+        i = (i + 1) & (self->glyph_table_size - 1);
     }
 
     return NULL;
@@ -515,6 +642,7 @@ texture_font_load_glyph( texture_font_t * self,
         if ( region.x < 0 )
         {
             fprintf( stderr, "Texture atlas is full (line %d)\n",  __LINE__ );
+            self->atlas_full = 1;
             return 0;
         }
         texture_atlas_set_region( self->atlas, region.x, region.y, 4, 4, data, 0 );
@@ -523,7 +651,8 @@ texture_font_load_glyph( texture_font_t * self,
         glyph->t0 = (region.y+2)/(float)self->atlas->height;
         glyph->s1 = (region.x+3)/(float)self->atlas->width;
         glyph->t1 = (region.y+3)/(float)self->atlas->height;
-        vector_push_back( self->glyphs, &glyph );
+        glyph->atlas = self->atlas;
+        texture_font_add_glyph( self, glyph );
         return 1;
     }
 
@@ -666,6 +795,16 @@ cleanup_stroker:
 
     size_t src_w = ft_bitmap.width/self->atlas->depth;
     size_t src_h = ft_bitmap.rows;
+    int sdf = self->rendermode == RENDER_SIGNED_DISTANCE_FIELD && src_w > 0 && src_h > 0;
+
+    /* Room for the distance field outside of the glyph */
+    if( sdf )
+    {
+        padding.left += self->padding;
+        padding.top += self->padding;
+        padding.right += self->padding;
+        padding.bottom += self->padding;
+    }
 
     size_t tgt_w = src_w + padding.left + padding.right;
     size_t tgt_h = src_h + padding.top + padding.bottom;
@@ -675,6 +814,7 @@ cleanup_stroker:
     if ( region.x < 0 )
     {
         fprintf( stderr, "Texture atlas is full (line %d)\n",  __LINE__ );
+        self->atlas_full = 1;
         return 0;
     }
 
@@ -688,11 +828,13 @@ cleanup_stroker:
         memcpy( buffer + (i + padding.top) * tgt_w + padding.left, ft_bitmap.buffer + i * ft_bitmap.pitch, src_w );
     }
 
-    if( self->rendermode == RENDER_SIGNED_DISTANCE_FIELD )
+    if( sdf )
     {
-        unsigned char *sdf = make_distance_mapb( buffer, tgt_w, tgt_h );
+        unsigned char *map = self->padding > 0 ?
+            make_distance_mapb_spread( buffer, tgt_w, tgt_h, self->padding ) :
+            make_distance_mapb( buffer, tgt_w, tgt_h );
         free( buffer );
-        buffer = sdf;
+        buffer = map;
     }
 
     texture_atlas_set_region( self->atlas, x, y, tgt_w, tgt_h, buffer, tgt_w );
@@ -707,10 +849,16 @@ cleanup_stroker:
     glyph->outline_thickness = self->outline_thickness;
     glyph->offset_x = ft_glyph_left;
     glyph->offset_y = ft_glyph_top;
+    if( sdf )
+    {
+        glyph->offset_x -= self->padding;
+        glyph->offset_y += self->padding;
+    }
     glyph->s0       = x/(float)self->atlas->width;
     glyph->t0       = y/(float)self->atlas->height;
     glyph->s1       = (x + glyph->width)/(float)self->atlas->width;
     glyph->t1       = (y + glyph->height)/(float)self->atlas->height;
+    glyph->atlas    = self->atlas;
 
     // Discard hinting to get advance
     FT_Load_Glyph( self->face, glyph_index, FT_LOAD_RENDER | FT_LOAD_NO_HINTING);
@@ -718,13 +866,11 @@ cleanup_stroker:
     glyph->advance_x = slot->advance.x / HRESf;
     glyph->advance_y = slot->advance.y / HRESf;
 
-    vector_push_back( self->glyphs, &glyph );
+    texture_font_add_glyph( self, glyph );
 
     if( self->rendermode != RENDER_NORMAL && self->rendermode != RENDER_SIGNED_DISTANCE_FIELD )
         FT_Done_Glyph( ft_glyph );
 
-    texture_font_generate_kerning( self );
-
     return 1;
 }
 
@@ -91,25 +91,31 @@ typedef enum rendermode_t
 
 
 /**
- * A structure that hold a kerning value relatively to a Unicode
- * codepoint.
- *
- * This structure cannot be used alone since the (necessary) right
- * Unicode codepoint is implicitely held by the owner of this structure.
+ * A cached kerning value of a Unicode codepoint pair.
  */
-typedef struct kerning_t
+typedef struct kerning_pair_t
 {
     /**
      * Left Unicode codepoint in the kern pair in UTF-32 LE encoding.
      */
-    uint32_t codepoint;
+    uint32_t left;
+
+    /**
+     * Right Unicode codepoint in the kern pair in UTF-32 LE encoding.
+     */
+    uint32_t right;
 
     /**
      * Kerning value (in fractional pixels).
      */
     float kerning;
 
-} kerning_t;
+    /**
+     * Whether the entry is set.
+     */
+    int used;
+
+} kerning_pair_t;
 
 
 
@@ -214,11 +220,6 @@ typedef struct texture_glyph_t
      */
     float t1;
 
-    /**
-     * A vector of kerning pairs relative to this glyph.
-     */
-    vector_t * kerning;
-
     /**
      * Mode this glyph was rendered
      */
@@ -229,6 +230,11 @@ typedef struct texture_glyph_t
      */
     float outline_thickness;
 
+    /**
+     * Atlas (page) holding the glyph bitmap
+     */
+    texture_atlas_t * atlas;
+
 } texture_glyph_t;
 
 
@@ -362,6 +368,21 @@ typedef struct texture_font_t
     int libraryShared;
     FT_Face face;
 
+    //glyph lookup (open addressing, keyed by codepoint)
+    texture_glyph_t **glyph_table;
+    size_t glyph_table_size;
+
+    //kerning cache (open addressing, keyed by codepoint pair)
+    kerning_pair_t *kerning_table;
+    size_t kerning_table_size;
+    size_t kerning_table_count;
+
+    //set if a glyph did not fit into the atlas (reset by caller)
+    int atlas_full;
+
+    //extra glyph border in pixels (distance field range, RENDER_SIGNED_DISTANCE_FIELD only)
+    int padding;
+
 } texture_font_t;
 
 
@@ -464,14 +485,33 @@ typedef struct texture_font_t
 /**
  * Get the kerning between two horizontal glyphs.
  *
- * @param self      A valid texture glyph
- * @param codepoint Character codepoint of the peceding character in UTF-8 encoding.
+ * Values are loaded on first use and cached per font.
+ *
+ * @param self  A valid texture font
+ * @param left  The preceding glyph
+ * @param right The current glyph
  *
  * @return x kerning value
  */
 float
-texture_glyph_get_kerning( const texture_glyph_t * self,
-                           const char * codepoint );
+texture_font_get_kerning( texture_font_t * self,
+                          const texture_glyph_t * left,
+                          const texture_glyph_t * right );
+
+
+/**
+ * Remove all glyphs stored in an atlas.
+ *
+ * Used to reuse an atlas page. The glyphs are loaded again on next use.
+ *
+ * @param self  A valid texture font
+ * @param atlas The atlas page to release
+ *
+ * @return Number of removed glyphs
+ */
+size_t
+texture_font_remove_glyphs( texture_font_t * self,
+                            const texture_atlas_t * atlas );
 
 
 /**
@@ -0,0 +1,504 @@
+#include "headless.h"
+
+#ifdef AMINO_BENCH
+#include "bench.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <execinfo.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+
+#define gettid() syscall(SYS_gettid)
+
+#define DEBUG_HEADLESS false
+
+//
+// AminoGfxHeadless
+//
+
+/**
+ * Headless AminoGfx implementation.
+ *
+ * Renders to an offscreen EGL pbuffer. Intended for build and CI servers without GPU or display
+ * (use LIBGL_ALWAYS_SOFTWARE=1 to force Mesa's software rasterizer).
+ *
+ * Notes:
+ *
+ *  - no input events
+ *  - window position and title are ignored
+ *  - video playback is not supported
+ */
+AminoGfxHeadless::AminoGfxHeadless(): AminoGfx(getFactory()->name) {
+    //empty
+}
+
+AminoGfxHeadless::~AminoGfxHeadless() {
+    if (!destroyed) {
+        destroyAminoGfxHeadless();
+    }
+}
+
+/**
+ * Get factory instance.
+ */
+AminoGfxHeadlessFactory* AminoGfxHeadless::getFactory() {
+    static AminoGfxHeadlessFactory *instance = NULL;
+
+    if (!instance) {
+        instance = new AminoGfxHeadlessFactory(New);
+    }
+
+    return instance;
+}
+
+/**
+ * Add class template to module exports.
+ */
+NAN_MODULE_INIT(AminoGfxHeadless::Init) {
+    AminoGfxHeadlessFactory *factory = getFactory();
+
+    AminoGfx::Init(target, factory);
+}
+
+/**
+ * JS object construction.
+ */
+NAN_METHOD(AminoGfxHeadless::New) {
+    AminoJSObject::createInstance(info, getFactory());
+}
+
+/**
+ * Setup JS instance.
+ */
+void AminoGfxHeadless::setup() {
+    if (DEBUG_HEADLESS) {
+        printf("AminoGfxHeadless.setup()\n");
+    }
+
+    //instance
+    addInstance();
+
+    //EGL display & context
+    initEGL();
+
+    //base class
+    AminoGfx::setup();
+}
+
+/**
+ * Get the EGL display.
+ *
+ * Prefers Mesa's surfaceless platform (no X11 or DRM device needed).
+ */
+EGLDisplay AminoGfxHeadless::getDisplay(bool &surfaceless) {
+    surfaceless = false;
+
+#ifdef EGL_MESA_platform_surfaceless
+    const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (extensions && strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+        if (getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+            if (display != EGL_NO_DISPLAY) {
+                surfaceless = true;
+
+                return display;
+            }
+        }
+    }
+#endif
+
+    //fallback
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+/**
+ * Initialize EGL display and context.
+ */
+void AminoGfxHeadless::initEGL() {
+    //get an EGL display connection
+    display = getDisplay(surfaceless);
+
+    assert(display != EGL_NO_DISPLAY);
+
+    //initialize the EGL display connection
+    EGLBoolean res = eglInitialize(display, NULL, NULL);
+
+    assert(EGL_FALSE != res);
+
+    //get an appropriate EGL frame buffer configuration
+    static const EGLint attribute_list[] = {
+        //RGBA
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+
+        //OpenGL ES 2.0
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+
+        //buffers
+        EGL_STENCIL_SIZE, 8,
+        EGL_DEPTH_SIZE, 16,
+
+        //offscreen
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+
+        EGL_NONE
+    };
+
+    EGLint num_config;
+
+    res = eglChooseConfig(display, attribute_list, &config, 1, &num_config);
+
+    assert(EGL_FALSE != res);
+    assert(num_config > 0);
+
+    //choose OpenGL ES 2
+    res = eglBindAPI(EGL_OPENGL_ES_API);
+
+    assert(EGL_FALSE != res);
+
+    //create an EGL rendering context
+    static const EGLint context_attributes[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+
+    assert(context != EGL_NO_CONTEXT);
+}
+
+/**
+ * Destroy EGL instance.
+ */
+void AminoGfxHeadless::destroy() {
+    if (destroyed) {
+        return;
+    }
+
+    //instance
+    destroyAminoGfxHeadless();
+
+    //destroy basic instance
+    AminoGfx::destroy();
+}
+
+/**
+ * Destroy EGL instance.
+ */
+void AminoGfxHeadless::destroyAminoGfxHeadless() {
+    //OpenGL ES
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+        if (context != EGL_NO_CONTEXT) {
+            eglDestroyContext(display, context);
+            context = EGL_NO_CONTEXT;
+        }
+
+        if (surface != EGL_NO_SURFACE) {
+            eglDestroySurface(display, surface);
+            surface = EGL_NO_SURFACE;
+        }
+
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+    }
+
+    removeInstance();
+
+    if (DEBUG_HEADLESS) {
+        printf("Destroyed headless EGL instance. Left=%i\n", instanceCount);
+    }
+}
+
+/**
+ * No physical screen.
+ */
+bool AminoGfxHeadless::getScreenInfo(int &w, int &h, int &refreshRate, bool &fullscreen) {
+    return false;
+}
+
+/**
+ * Add EGL properties.
+ */
+void AminoGfxHeadless::populateRuntimeProperties(v8::Local<v8::Object> &obj) {
+    if (DEBUG_HEADLESS) {
+        printf("populateRuntimeProperties\n");
+    }
+
+    AminoGfx::populateRuntimeProperties(obj);
+
+    //EGL
+    Nan::Set(obj, Nan::New("eglVendor").ToLocalChecked(), Nan::New(std::string(eglQueryString(display, EGL_VENDOR))).ToLocalChecked());
+    Nan::Set(obj, Nan::New("eglVersion").ToLocalChecked(), Nan::New(std::string(eglQueryString(display, EGL_VERSION))).ToLocalChecked());
+
+    //headless
+    Nan::Set(obj, Nan::New("headless").ToLocalChecked(), Nan::New<v8::Boolean>(true));
+    Nan::Set(obj, Nan::New("surfaceless").ToLocalChecked(), Nan::New<v8::Boolean>(surfaceless));
+}
+
+/**
+ * Create the offscreen surface.
+ */
+void AminoGfxHeadless::initRenderer() {
+    //base
+    AminoGfx::initRenderer();
+
+    //create pbuffer surface
+    const EGLint pbuffer_attributes[] = {
+        EGL_WIDTH, viewportW,
+        EGL_HEIGHT, viewportH,
+        EGL_NONE
+    };
+
+    surface = eglCreatePbufferSurface(display, config, pbuffer_attributes);
+
+    assert(surface != EGL_NO_SURFACE);
+
+    if (DEBUG_HEADLESS) {
+        printf("pbuffer size: %ix%i\n", viewportW, viewportH);
+    }
+
+    //activate context (needed by JS code to create shaders)
+    EGLBoolean res = eglMakeCurrent(display, surface, surface, context);
+
+    assert(EGL_FALSE != res);
+}
+
+void AminoGfxHeadless::start() {
+    //ready to get control back to JS code
+    ready();
+
+    //detach context from main thread
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+bool AminoGfxHeadless::bindContext() {
+    //bind OpenGL context
+    if (surface == EGL_NO_SURFACE) {
+        return false;
+    }
+
+    EGLBoolean res = eglMakeCurrent(display, surface, surface, context);
+
+    assert(res == EGL_TRUE);
+
+    return true;
+}
+
+void AminoGfxHeadless::renderingDone() {
+    if (DEBUG_HEADLESS) {
+        printf("renderingDone()\n");
+    }
+
+    //wait for the rasterizer (pbuffer swap is a no-op)
+    glFinish();
+}
+
+/**
+ * Get the age of the back buffer.
+ *
+ * Note: single buffered (content of the last frame)
+ */
+int AminoGfxHeadless::getBufferAge() {
+    return 1;
+}
+
+void AminoGfxHeadless::handleSystemEvents() {
+    //no input devices
+}
+
+/**
+ * Update the window size.
+ *
+ * Note: has to be called on main thread
+ */
+void AminoGfxHeadless::updateWindowSize() {
+    //ignore size changes before surface is created
+    if (surface == EGL_NO_SURFACE) {
+        return;
+    }
+
+    //not supported (fixed pbuffer size)
+    propW->setValue(viewportW);
+    propH->setValue(viewportH);
+}
+
+/**
+ * Update the window position.
+ *
+ * Note: has to be called on main thread
+ */
+void AminoGfxHeadless::updateWindowPosition() {
+    //not supported
+}
+
+/**
+ * Update the title.
+ *
+ * Note: has to be called on main thread
+ */
+void AminoGfxHeadless::updateWindowTitle() {
+    //not supported
+}
+
+/**
+ * Shared atlas texture has changed.
+ */
+void AminoGfxHeadless::atlasTextureHasChanged(amino_atlas_page_t *page) {
+    //check single instance case
+    if (instanceCount == 1) {
+        return;
+    }
+
+    //run on main thread
+    enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfxHeadless::atlasTextureHasChangedHandler), NULL, page);
+}
+
+/**
+ * Handle on main thread.
+ */
+void AminoGfxHeadless::atlasTextureHasChangedHandler(JSCallbackUpdate *update) {
+    AminoGfx *gfx = static_cast<AminoGfx *>(update->obj);
+    amino_atlas_page_t *page = (amino_atlas_page_t *)update->data;
+
+    for (auto const &item : instances) {
+        if (gfx == item) {
+            continue;
+        }
+
+        static_cast<AminoGfxHeadless *>(item)->updateAtlasTexture(page);
+    }
+}
+
+/**
+ * Create video player.
+ */
+AminoVideoPlayer* AminoGfxHeadless::createVideoPlayer(AminoTexture *texture, AminoVideo *video) {
+    return new AminoHeadlessVideoPlayer(texture, video);
+}
+
+//
+// AminoGfxHeadlessFactory
+//
+
+/**
+ * Create AminoGfx factory.
+ */
+AminoGfxHeadlessFactory::AminoGfxHeadlessFactory(Nan::FunctionCallback callback): AminoJSObjectFactory("AminoGfx", callback) {
+    //empty
+}
+
+/**
+ * Create AminoGfx instance.
+ */
+AminoJSObject* AminoGfxHeadlessFactory::create() {
+    return new AminoGfxHeadless();
+}
+
+//
+// AminoHeadlessVideoPlayer
+//
+
+AminoHeadlessVideoPlayer::AminoHeadlessVideoPlayer(AminoTexture *texture, AminoVideo *video): AminoVideoPlayer(texture, video) {
+    //empty
+}
+
+/**
+ * Initialize the stream (on main thread).
+ */
+bool AminoHeadlessVideoPlayer::initStream() {
+    lastError = "video playback not supported";
+
+    return false;
+}
+
+void AminoHeadlessVideoPlayer::init() {
+    //not supported
+    handleInitDone(false);
+}
+
+void AminoHeadlessVideoPlayer::initVideoTexture() {
+    //not supported
+}
+
+void AminoHeadlessVideoPlayer::updateVideoTexture(GLContext *ctx) {
+    //not supported
+}
+
+double AminoHeadlessVideoPlayer::getMediaTime() {
+    return -1;
+}
+
+double AminoHeadlessVideoPlayer::getDuration() {
+    return -1;
+}
+
+double AminoHeadlessVideoPlayer::getFramerate() {
+    return 0;
+}
+
+void AminoHeadlessVideoPlayer::stopPlayback() {
+    //not supported
+}
+
+bool AminoHeadlessVideoPlayer::pausePlayback() {
+    return false;
+}
+
+bool AminoHeadlessVideoPlayer::resumePlayback() {
+    return false;
+}
+
+//
+// Crash handler
+//
+
+void crashHandler(int sig) {
+    void *array[10];
+    size_t size;
+
+    //process & thread
+    pid_t pid = getpid();
+    pid_t tid = gettid();
+    uv_thread_t threadId = uv_thread_self();
+
+    //get void*'s for all entries on the stack
+    size = backtrace(array, 10);
+
+    //print out all the frames to stderr
+    fprintf(stderr, "Error: signal %d (process=%d, thread=%d, uvThread=%lu):\n", sig, pid, tid, (unsigned long)threadId);
+    backtrace_symbols_fd(array, size, STDERR_FILENO);
+    exit(1);
+}
+
+// ========== Event Callbacks ===========
+
+NAN_MODULE_INIT(InitAll) {
+    //crash handler
+    signal(SIGSEGV, crashHandler);
+
+    //main class
+    AminoGfxHeadless::Init(target);
+
+    //amino classes
+    AminoGfx::InitClasses(target);
+
+#ifdef AMINO_BENCH
+    //benchmarks
+    AminoBench::Init(target);
+#endif
+}
+
+//entry point
+NODE_MODULE(aminonative, InitAll)
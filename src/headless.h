@@ -0,0 +1,86 @@
+#ifndef _AMINO_HEADLESS_H
+#define _AMINO_HEADLESS_H
+
+#include "base.h"
+#include "renderer.h"
+
+class AminoGfxHeadlessFactory : public AminoJSObjectFactory {
+public:
+    AminoGfxHeadlessFactory(Nan::FunctionCallback callback);
+
+    AminoJSObject* create() override;
+};
+
+/**
+ * Headless AminoGfx implementation (offscreen EGL pbuffer).
+ */
+class AminoGfxHeadless : public AminoGfx {
+public:
+    AminoGfxHeadless();
+    ~AminoGfxHeadless();
+
+    static AminoGfxHeadlessFactory* getFactory();
+    static NAN_MODULE_INIT(Init);
+
+private:
+    //OpenGL ES
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLConfig config;
+    bool surfaceless = false;
+
+    static NAN_METHOD(New);
+
+    void setup() override;
+    void initEGL();
+    static EGLDisplay getDisplay(bool &surfaceless);
+
+    void destroy() override;
+    void destroyAminoGfxHeadless();
+
+    bool getScreenInfo(int &w, int &h, int &refreshRate, bool &fullscreen) override;
+
+    void populateRuntimeProperties(v8::Local<v8::Object> &obj) override;
+    void initRenderer() override;
+
+    void start() override;
+    bool bindContext() override;
+    void renderingDone() override;
+    int getBufferAge() override;
+    void handleSystemEvents() override;
+
+    void updateWindowSize() override;
+    void updateWindowPosition() override;
+    void updateWindowTitle() override;
+
+    void atlasTextureHasChanged(amino_atlas_page_t *page) override;
+    void atlasTextureHasChangedHandler(JSCallbackUpdate *update);
+
+    AminoVideoPlayer *createVideoPlayer(AminoTexture *texture, AminoVideo *video) override;
+};
+
+/**
+ * Headless video player.
+ *
+ * Note: video playback is not supported.
+ */
+class AminoHeadlessVideoPlayer : public AminoVideoPlayer {
+public:
+    AminoHeadlessVideoPlayer(AminoTexture *texture, AminoVideo *video);
+
+    bool initStream() override;
+    void init() override;
+    void initVideoTexture() override;
+    void updateVideoTexture(GLContext *ctx) override;
+
+    //metadata
+    double getMediaTime() override;
+    double getDuration() override;
+    double getFramerate() override;
+    void stopPlayback() override;
+    bool pausePlayback() override;
+    bool resumePlayback() override;
+};
+
+#endif
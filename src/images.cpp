@@ -93,6 +93,29 @@ public:
         bufferLen = node::Buffer::Length(bufferObj);
     }
 
+    /**
+     * Decode without JS callback (see AminoImage::decodeImage()).
+     */
+    AsyncImageWorker(char *buffer, size_t bufferLen) : AsyncWorker(NULL), buffer(buffer), bufferLen(bufferLen) {
+        //empty
+    }
+
+    ~AsyncImageWorker() {
+        //not transferred to a buffer
+        if (imgData) {
+            free(imgData);
+        }
+    }
+
+    /**
+     * Get the decoded image size.
+     */
+    void getImageSize(int &w, int &h, int &bpp) {
+        w = imgW;
+        h = imgH;
+        bpp = imgBPP;
+    }
+
     /**
      * Async running code.
      */
@@ -404,6 +427,7 @@ public:
 
         //transfer ownership
         buff = Nan::NewBuffer(imgData, imgDataLen).ToLocalChecked();
+        imgData = NULL;
 
         //create object
         Nan::Set(obj, Nan::New("w").ToLocalChecked(),      Nan::New(imgW));
@@ -621,6 +645,25 @@ NAN_METHOD(AminoImage::loadImage) {
     AsyncQueueWorker(new AsyncImageWorker(callback, obj, bufferObj));
 }
 
+/**
+ * Decode image on the calling thread.
+ *
+ * Note: used by the benchmarks.
+ */
+bool AminoImage::decodeImage(char *bufferData, size_t bufferLength, int &w, int &h, int &bpp) {
+    AsyncImageWorker worker(bufferData, bufferLength);
+
+    worker.Execute();
+
+    if (worker.ErrorMessage()) {
+        return false;
+    }
+
+    worker.getImageSize(w, h, bpp);
+
+    return true;
+}
+
 /**
  * Create local copy of JS values.
  */
@@ -1175,6 +1218,11 @@ void AminoTexture::videoPlayerInitDone() {
 
     //switch to main thread
     enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoTexture::handleVideoPlayerInitDone), NULL, NULL);
+
+    //show frames
+    if (eventHandler) {
+        (static_cast<AminoGfx *>(eventHandler))->wakeUp();
+    }
 }
 
 /**
@@ -1252,6 +1300,30 @@ void AminoTexture::prepareTexture(GLContext *ctx) {
     uv_mutex_unlock(&videoLock);
 }
 
+/**
+ * Check if the texture shows a video (content changes every frame).
+ */
+bool AminoTexture::hasVideo() {
+    return videoLockUsed;
+}
+
+/**
+ * Check if the video is playing right now.
+ */
+bool AminoTexture::isVideoPlaying() {
+    if (!videoLockUsed) {
+        return false;
+    }
+
+    uv_mutex_lock(&videoLock);
+
+    bool playing = videoPlayer && videoPlayer->isPlaying();
+
+    uv_mutex_unlock(&videoLock);
+
+    return playing;
+}
+
 /**
  * Fire video event.
  */
@@ -1629,6 +1701,11 @@ NAN_METHOD(AminoTexture::ResumePlayback) {
 
     if (obj->videoPlayer) {
         obj->videoPlayer->resumePlayback();
+
+        //show frames
+        if (obj->eventHandler) {
+            (static_cast<AminoGfx *>(obj->eventHandler))->wakeUp();
+        }
     }
 }
 
@@ -28,6 +28,8 @@ public:
     GLuint createTexture(GLuint textureId);
     static GLuint createTexture(GLuint textureId, char *bufferData, size_t bufferLength, int w, int h, int bpp);
 
+    static bool decodeImage(char *bufferData, size_t bufferLength, int &w, int &h, int &bpp);
+
     void imageLoaded(v8::Local<v8::Object> &buffer, int w, int h, bool alpha, int bpp);
 
     //creation
@@ -86,6 +88,8 @@ public:
 
     //texture
     GLuint getTexture();
+    bool hasVideo();
+    bool isVideoPlaying();
 
     //video
     void initVideoTexture();
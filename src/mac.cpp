@@ -240,6 +240,7 @@ private:
         //get framebuffer size
         glfwGetFramebufferSize(window, &viewportW, &viewportH);
         viewportChanged = true;
+        wakeUp();
 
         //check framebuffer size
         if (DEBUG_GLFW) {
@@ -435,6 +436,7 @@ private:
 
         glfwGetFramebufferSize(window, &viewportW, &viewportH);
         viewportChanged = true;
+        wakeUp();
 
         //check framebuffer size
         if (DEBUG_GLFW) {
@@ -577,6 +579,7 @@ private:
         //get framebuffer size
         glfwGetFramebufferSize(window, &viewportW, &viewportH);
         viewportChanged = true;
+        wakeUp();
 
         //check framebuffer size
         if (DEBUG_GLFW) {
@@ -619,14 +622,14 @@ private:
     /**
      * Shared atlas texture has changed.
      */
-    void atlasTextureHasChanged(texture_atlas_t *atlas) override {
+    void atlasTextureHasChanged(amino_atlas_page_t *page) override {
         //check single instance case
         if (instanceCount == 1) {
             return;
         }
 
         //run on main thread
-        enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfxMac::atlasTextureHasChangedHandler), NULL, atlas);
+        enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfxMac::atlasTextureHasChangedHandler), NULL, page);
     }
 
     /**
@@ -634,14 +637,14 @@ private:
      */
     void atlasTextureHasChangedHandler(JSCallbackUpdate *update) {
         AminoGfx *gfx = static_cast<AminoGfx *>(update->obj);
-        texture_atlas_t *atlas = (texture_atlas_t *)update->data;
+        amino_atlas_page_t *page = (amino_atlas_page_t *)update->data;
 
         for (auto const &item : *windowMap) {
             if (gfx == item.second) {
                 continue;
             }
 
-            item.second->updateAtlasTexture(atlas);
+            item.second->updateAtlasTexture(page);
         }
     }
 
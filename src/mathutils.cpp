@@ -1,5 +1,13 @@
 #include "mathutils.h"
 
+//SIMD matrix multiplication (ARM only: x86 compilers auto-vectorize the scalar loop, which beat the SSE version)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MATRIX_NEON
+#endif
+
+#define DEG_TO_RAD ((float)(M_PI / 180.0))
+
 /**
  * Reset 4x4 matrix with zero values.
  */
@@ -15,9 +23,9 @@ void clear_matrix(GLfloat *m) {
  * @param angle angle in degrees.
  */
 void make_y_rot_matrix(GLfloat angle, GLfloat *m) {
-    float rad = angle * M_PI / 180.0f;
-    float c = cos(rad);
-    float s = sin(rad);
+    float rad = angle * DEG_TO_RAD;
+    float c = cosf(rad);
+    float s = sinf(rad);
 
     //reset
     for (int i = 0; i < 16; i++) {
@@ -40,9 +48,9 @@ void make_y_rot_matrix(GLfloat angle, GLfloat *m) {
  * @param angle angle in degrees.
  */
 void make_z_rot_matrix(GLfloat angle, GLfloat *m) {
-    float rad = angle * M_PI / 180.0f;
-    float c = cos(rad);
-    float s = sin(rad);
+    float rad = angle * DEG_TO_RAD;
+    float c = cosf(rad);
+    float s = sinf(rad);
 
     //reset
     for (int i = 0; i < 16; i++) {
@@ -65,9 +73,9 @@ void make_z_rot_matrix(GLfloat angle, GLfloat *m) {
  * @param angle angle in degrees.
  */
 void make_x_rot_matrix(GLfloat angle, GLfloat *m) {
-    float rad = angle * M_PI / 180.0f;
-    float c = cos(rad);
-    float s = sin(rad);
+    float rad = angle * DEG_TO_RAD;
+    float c = cosf(rad);
+    float s = sinf(rad);
 
     //reset
     for (int i = 0; i < 16; i++) {
@@ -147,6 +155,97 @@ void make_trans_matrix(GLfloat x, GLfloat y, GLfloat z, GLfloat *m) {
     m[14] = z;
 }
 
+/**
+ * Create rotation matrix (Rx * Ry * Rz).
+ *
+ * Same result as the multiplied single axis matrices.
+ *
+ * @param rx angle in degrees.
+ * @param ry angle in degrees.
+ * @param rz angle in degrees.
+ */
+void make_rot_matrix(GLfloat rx, GLfloat ry, GLfloat rz, GLfloat *m) {
+    float cx = 1, sx = 0, cy = 1, sy = 0, cz = 1, sz = 0;
+
+    if (rx != 0) {
+        float rad = rx * DEG_TO_RAD;
+
+        cx = cosf(rad);
+        sx = sinf(rad);
+    }
+
+    if (ry != 0) {
+        float rad = ry * DEG_TO_RAD;
+
+        cy = cosf(rad);
+        sy = sinf(rad);
+    }
+
+    if (rz != 0) {
+        float rad = rz * DEG_TO_RAD;
+
+        cz = cosf(rad);
+        sz = sinf(rad);
+    }
+
+    //column 0
+    m[0] = cy * cz;
+    m[1] = cx * sz + sx * sy * cz;
+    m[2] = sx * sz - cx * sy * cz;
+    m[3] = 0;
+
+    //column 1
+    m[4] = -cy * sz;
+    m[5] = cx * cz - sx * sy * sz;
+    m[6] = sx * cz + cx * sy * sz;
+    m[7] = 0;
+
+    //column 2
+    m[8]  = sy;
+    m[9]  = -sx * cy;
+    m[10] = cx * cy;
+    m[11] = 0;
+
+    //column 3
+    m[12] = 0;
+    m[13] = 0;
+    m[14] = 0;
+    m[15] = 1;
+}
+
+/**
+ * Create node transformation matrix.
+ *
+ * Same result as T(ox, oy) * T(x, y, z) * S(sx, sy) * Rx * Ry * Rz * T(-ox, -oy) but without full matrix multiplications.
+ *
+ * @param rx angle in degrees.
+ * @param ry angle in degrees.
+ * @param rz angle in degrees.
+ */
+void make_node_matrix(GLfloat x, GLfloat y, GLfloat z, GLfloat sx, GLfloat sy, GLfloat rx, GLfloat ry, GLfloat rz, GLfloat ox, GLfloat oy, GLfloat *m) {
+    //rotation (skip unused axes)
+    if (rx == 0 && ry == 0) {
+        if (rz == 0) {
+            make_identity_matrix(m);
+        } else {
+            make_z_rot_matrix(rz, m);
+        }
+    } else {
+        make_rot_matrix(rx, ry, rz, m);
+    }
+
+    //scale (first two rows)
+    for (int col = 0; col < 3; col++) {
+        m[col * 4]     *= sx;
+        m[col * 4 + 1] *= sy;
+    }
+
+    //translation (including origin)
+    m[12] = ox + x - (m[0] * ox + m[4] * oy);
+    m[13] = oy + y - (m[1] * ox + m[5] * oy);
+    m[14] = z - (m[2] * ox + m[6] * oy);
+}
+
 /**
  * Create z-translation matrix.
  */
@@ -338,9 +437,79 @@ bool make_square_to_quad_matrix(GLfloat dx0, GLfloat dy0, GLfloat dx1, GLfloat d
 /**
  * Matrix multiplication (4x4).
  *
- * @param prod result
+ * Uses NEON if available. Same results as mul_matrix_scalar().
+ *
+ * @param prod result (may be a or b)
  */
 void mul_matrix(GLfloat *prod, const GLfloat *a, const GLfloat *b) {
+#if defined(MATRIX_NEON)
+    float32x4_t a0 = vld1q_f32(a);
+    float32x4_t a1 = vld1q_f32(a + 4);
+    float32x4_t a2 = vld1q_f32(a + 8);
+    float32x4_t a3 = vld1q_f32(a + 12);
+    float32x4_t p[4];
+
+    for (int i = 0; i < 4; i++) {
+        const GLfloat *bi = b + i * 4;
+        float32x4_t col = vmulq_n_f32(a0, bi[0]);
+
+        col = vaddq_f32(col, vmulq_n_f32(a1, bi[1]));
+        col = vaddq_f32(col, vmulq_n_f32(a2, bi[2]));
+        col = vaddq_f32(col, vmulq_n_f32(a3, bi[3]));
+        p[i] = col;
+    }
+
+    vst1q_f32(prod, p[0]);
+    vst1q_f32(prod + 4, p[1]);
+    vst1q_f32(prod + 8, p[2]);
+    vst1q_f32(prod + 12, p[3]);
+#else
+    mul_matrix_scalar(prod, a, b);
+#endif
+}
+
+/**
+ * 2D affine matrix multiplication.
+ *
+ * Note: a and b have to be 2D affine matrices (no z values, rotation around z-axis only).
+ *
+ * @param prod result (may be a or b)
+ */
+void mul_matrix_affine(GLfloat *prod, const GLfloat *a, const GLfloat *b) {
+    GLfloat p0  = a[0] * b[0]  + a[4] * b[1];
+    GLfloat p1  = a[1] * b[0]  + a[5] * b[1];
+    GLfloat p4  = a[0] * b[4]  + a[4] * b[5];
+    GLfloat p5  = a[1] * b[4]  + a[5] * b[5];
+    GLfloat p12 = a[0] * b[12] + a[4] * b[13] + a[12];
+    GLfloat p13 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+    prod[0] = p0;
+    prod[1] = p1;
+    prod[2] = 0;
+    prod[3] = 0;
+
+    prod[4] = p4;
+    prod[5] = p5;
+    prod[6] = 0;
+    prod[7] = 0;
+
+    prod[8]  = 0;
+    prod[9]  = 0;
+    prod[10] = 1;
+    prod[11] = 0;
+
+    prod[12] = p12;
+    prod[13] = p13;
+    prod[14] = 0;
+    prod[15] = 1;
+}
+
+/**
+ * Matrix multiplication (4x4, reference implementation).
+ *
+ * @param prod result
+ */
+void mul_matrix_scalar(GLfloat *prod, const GLfloat *a, const GLfloat *b) {
 #define A(row,col)  a[(col<<2)+row]
 #define B(row,col)  b[(col<<2)+row]
 #define P(row,col)  p[(col<<2)+row]
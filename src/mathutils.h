@@ -26,6 +26,8 @@ void make_identity_matrix(GLfloat *m);
 void make_scale_matrix(GLfloat xs, GLfloat ys, GLfloat zs, GLfloat *m);
 void make_trans_matrix(GLfloat x, GLfloat y, GLfloat z, GLfloat *m);
 void make_trans_z_matrix(GLfloat z, GLfloat *m);
+void make_rot_matrix(GLfloat rx, GLfloat ry, GLfloat rz, GLfloat *m);
+void make_node_matrix(GLfloat x, GLfloat y, GLfloat z, GLfloat sx, GLfloat sy, GLfloat rx, GLfloat ry, GLfloat rz, GLfloat ox, GLfloat oy, GLfloat *m);
 void make_shear_x_matrix(GLfloat sx, GLfloat *m);
 void make_shear_y_matrix(GLfloat sy, GLfloat *m);
 
@@ -34,6 +36,8 @@ bool make_quad_to_square_matrix(GLfloat sx0, GLfloat sy0, GLfloat sx1, GLfloat s
 bool make_square_to_quad_matrix(GLfloat dx0, GLfloat dy0, GLfloat dx1, GLfloat dy1, GLfloat dx2, GLfloat dy2, GLfloat dx3, GLfloat dy3, GLfloat *matrix);
 
 void mul_matrix(GLfloat *prod, const GLfloat *a, const GLfloat *b);
+void mul_matrix_scalar(GLfloat *prod, const GLfloat *a, const GLfloat *b);
+void mul_matrix_affine(GLfloat *prod, const GLfloat *a, const GLfloat *b);
 
 void loadOrthoMatrix(GLfloat *modelView, GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat near, GLfloat far);
 
@@ -4,6 +4,9 @@
 #define DEBUG_RENDERER_ERRORS false
 #define DEBUG_FONT_PERFORMANCE 0
 
+//max vertices per batch (6 per rect)
+const int BATCH_MAX_VERTICES = 6 * 1024;
+
 /**
  * OpenGL ES 2.0 renderer.
  */
@@ -46,6 +49,13 @@ AminoRenderer::~AminoRenderer () {
         fontShader = NULL;
     }
 
+    //SDF font shader
+    if (sdfFontShader) {
+        sdfFontShader->destroy();
+        delete sdfFontShader;
+        sdfFontShader = NULL;
+    }
+
     //color lighting shader
     if (colorLightingShader) {
         colorLightingShader->destroy();
@@ -60,6 +70,32 @@ AminoRenderer::~AminoRenderer () {
         textureLightingShader = NULL;
     }
 
+    //batch shaders
+    if (batchColorShader) {
+        batchColorShader->destroy();
+        delete batchColorShader;
+        batchColorShader = NULL;
+    }
+
+    if (batchTextureShader) {
+        batchTextureShader->destroy();
+        delete batchTextureShader;
+        batchTextureShader = NULL;
+    }
+
+    //batch buffer
+    if (batchBuffer != INVALID_BUFFER) {
+        glDeleteBuffers(1, &batchBuffer);
+        batchBuffer = INVALID_BUFFER;
+    }
+
+    //layers
+    for (std::map<AminoGroup *, amino_layer_t>::iterator it = layers.begin(); it != layers.end(); it++) {
+        freeLayer(it->second);
+    }
+
+    layers.clear();
+
     //context
     if (ctx) {
         delete ctx;
@@ -97,6 +133,29 @@ void AminoRenderer::setup() {
 
     assert(res);
 
+    sdfFontShader = new AminoSdfFontShader();
+    res = sdfFontShader->create();
+
+    assert(res);
+
+    //batch shaders
+    batchColorShader = new BatchColorShader();
+    res = batchColorShader->create();
+
+    assert(res);
+
+    batchTextureShader = new BatchTextureShader();
+    res = batchTextureShader->create();
+
+    assert(res);
+
+    //streaming vertex buffer
+    glGenBuffers(1, &batchBuffer);
+    batchVertices.reserve(BATCH_MAX_VERTICES * BatchColorShader::STRIDE);
+
+    //layer size limit
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
     //context
     ctx = new GLContext();
 }
@@ -220,6 +279,9 @@ void AminoRenderer::setupPerspective(v8::Local<v8::Object> &perspective) {
  * Update the model view projection matrix.
  */
 void AminoRenderer::updateViewport(GLfloat width, GLfloat height, GLfloat viewportW, GLfloat viewportH) {
+    //screen bounds changed
+    commandsValid = false;
+
     //set up the viewport (y-inversion, top-left origin)
 
     //scale
@@ -313,6 +375,9 @@ void AminoRenderer::updateViewport(GLfloat width, GLfloat height, GLfloat viewpo
 
     //set viewport
     glViewport(0, 0, viewportW, viewportH);
+
+    this->viewportW = viewportW;
+    this->viewportH = viewportH;
 }
 
 /**
@@ -323,6 +388,15 @@ void AminoRenderer::initScene(GLfloat r, GLfloat g, GLfloat b, GLfloat opacity)
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
 
+    //partial redraw
+    if (damageUsed) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(damageRect[0], damageRect[1], damageRect[2], damageRect[3]);
+
+        scissorUsed = true;
+        memcpy(scissorRect, damageRect, sizeof scissorRect);
+    }
+
     //prepare
     glClearColor(r, g, b, opacity);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -331,94 +405,1184 @@ void AminoRenderer::initScene(GLfloat r, GLfloat g, GLfloat b, GLfloat opacity)
     glDepthMask(GL_FALSE);
 }
 
+/**
+ * Update the command list and the area to draw.
+ *
+ * Returns false if nothing changed since the last frame (partial redraw).
+ */
+bool AminoRenderer::updateScene(AminoNode *node, int bufferAge) {
+    if (DEBUG_RENDERER) {
+        printf("-> updateScene()\n");
+    }
+
+    //stats
+    batchCount = 0;
+    batchNodeCount = 0;
+    recordCount = 0;
+    scissorCount = 0;
+    stencilCount = 0;
+    matrixCount = 0;
+    layerRenderCount = 0;
+    uploadBytes = 0;
+    frameCount++;
+
+    //no damage
+    frameDamage[0] = FLT_MAX;
+    frameDamage[1] = FLT_MAX;
+    frameDamage[2] = -FLT_MAX;
+    frameDamage[3] = -FLT_MAX;
+
+    //update command list
+    updateCommands(node);
+
+    damageUsed = false;
+
+    if (!partialRedraw) {
+        return true;
+    }
+
+    if (damageInvalid) {
+        damageInvalid = false;
+        addFullDamage();
+    } else {
+        addVideoDamage();
+    }
+
+    //nothing visible changed (front buffer is still valid)
+    if (fmax(frameDamage[0], -1) >= fmin(frameDamage[2], 1) || fmax(frameDamage[1], -1) >= fmin(frameDamage[3], 1)) {
+        skippedFrames++;
+
+        return false;
+    }
+
+    //add the damage of the frames missing in the back buffer
+    memcpy(damageArea, frameDamage, sizeof damageArea);
+
+    if (bufferAge <= 0 || bufferAge - 1 > damageHistorySize) {
+        //unknown content
+        damageArea[0] = -1;
+        damageArea[1] = -1;
+        damageArea[2] = 1;
+        damageArea[3] = 1;
+    } else {
+        for (int i = 0; i < bufferAge - 1; i++) {
+            GLfloat *bounds = damageHistory[i];
+
+            damageArea[0] = fmin(damageArea[0], bounds[0]);
+            damageArea[1] = fmin(damageArea[1], bounds[1]);
+            damageArea[2] = fmax(damageArea[2], bounds[2]);
+            damageArea[3] = fmax(damageArea[3], bounds[3]);
+        }
+    }
+
+    //visible area
+    damageArea[0] = fmax(damageArea[0], -1);
+    damageArea[1] = fmax(damageArea[1], -1);
+    damageArea[2] = fmin(damageArea[2], 1);
+    damageArea[3] = fmin(damageArea[3], 1);
+
+    updateDamageHistory();
+
+    //window coordinates (one pixel border: anti-aliasing)
+    GLint w = viewportW;
+    GLint h = viewportH;
+    GLint left   = std::max((GLint)floor((damageArea[0] + 1) / 2 * w) - 1, 0);
+    GLint bottom = std::max((GLint)floor((damageArea[1] + 1) / 2 * h) - 1, 0);
+    GLint right  = std::min((GLint)ceil((damageArea[2] + 1) / 2 * w) + 1, w);
+    GLint top    = std::min((GLint)ceil((damageArea[3] + 1) / 2 * h) + 1, h);
+
+    damageRect[0] = left;
+    damageRect[1] = bottom;
+    damageRect[2] = right - left;
+    damageRect[3] = top - bottom;
+
+    damageUsed = damageRect[2] < w || damageRect[3] < h;
+    lastDamageRatio = w > 0 && h > 0 ? (double)damageRect[2] * damageRect[3] / ((double)w * h):1;
+
+    return true;
+}
+
 /**
  * Render a complete scene.
+ *
+ * Note: call updateScene() and initScene() first.
  */
 void AminoRenderer::renderScene(AminoNode *node) {
     if (DEBUG_RENDERER) {
         printf("-> renderScene()\n");
     }
 
-    render(node);
+    //draw
+    render();
+
+    //draw remaining batch
+    flushBatch();
+
+    //partial redraw
+    if (damageUsed) {
+        glDisable(GL_SCISSOR_TEST);
+        scissorUsed = false;
+    }
+
+    lastBatchCount = batchCount;
+    lastBatchNodeCount = batchNodeCount;
+    lastRecordCount = recordCount;
+    lastScissorCount = scissorCount;
+    lastStencilCount = stencilCount;
+    lastLayerRenderCount = layerRenderCount;
+    lastUploadBytes = uploadBytes;
+
+    assert(clipStack.empty());
+    assert(stencilDepth == 0);
+    lastMatrixCount = matrixCount;
 
     ctx->reset();
 }
 
 /**
- * Render a node.
+ * Update the command list.
+ *
+ * Only the modified subtrees are recorded again. The complete list is rebuilt if the root or the number of commands changes.
  */
-void AminoRenderer::render(AminoNode *root) {
-    if (DEBUG_RENDERER) {
-        printf("-> render()\n");
+void AminoRenderer::updateCommands(AminoNode *root) {
+    if (!commandsValid || root != lastRoot || root->renderDirty || (root->renderChildDirty && !updateChildCommands(static_cast<AminoGroup *>(root)))) {
+        if (DEBUG_RENDERER) {
+            printf("-> rebuilding command list\n");
+        }
+
+        GLfloat identity[16];
+        GLfloat viewport[4] = { -1, -1, 1, 1 };
+
+        make_identity_matrix(identity);
+
+        commands.clear();
+        record(root, identity, root != lastRoot, 1, viewport, commands, 0);
+
+        lastRoot = root;
+        commandsValid = true;
+        rebuildCount++;
+
+        if (partialRedraw) {
+            addFullDamage();
+        }
     }
+}
 
-    if (root == NULL) {
-        printf("WARNING. NULL NODE!\n");
-        return;
+/**
+ * Add the screen bounds of drawn commands to the damaged area.
+ */
+void AminoRenderer::addDamage(std::size_t start, std::size_t end) {
+    for (std::size_t i = start; i < end; i++) {
+        amino_render_cmd_t *cmd = &commands[i];
+
+        if (cmd->type != CMD_DRAW && cmd->type != CMD_LAYER_BEGIN) {
+            continue;
+        }
+
+        AminoNode *node = cmd->node;
+
+        if (!node->renderHasBounds) {
+            //unknown area
+            addFullDamage();
+            return;
+        }
+
+        addDamage(node->renderBounds);
+    }
+}
+
+/**
+ * Add a normalized device coordinates area to the damaged area.
+ */
+void AminoRenderer::addDamage(GLfloat *bounds) {
+    frameDamage[0] = fmin(frameDamage[0], bounds[0]);
+    frameDamage[1] = fmin(frameDamage[1], bounds[1]);
+    frameDamage[2] = fmax(frameDamage[2], bounds[2]);
+    frameDamage[3] = fmax(frameDamage[3], bounds[3]);
+}
+
+/**
+ * Damage the whole screen.
+ */
+void AminoRenderer::addFullDamage() {
+    GLfloat bounds[4] = { -1, -1, 1, 1 };
+
+    addDamage(bounds);
+}
+
+/**
+ * Add the area of all visible videos (new frame on each cycle).
+ */
+void AminoRenderer::addVideoDamage() {
+    std::size_t count = commands.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        amino_render_cmd_t *cmd = &commands[i];
+
+        if (cmd->type != CMD_DRAW) {
+            continue;
+        }
+
+        AminoTexture *texture = getNodeTexture(cmd->node);
+
+        if (texture && texture->hasVideo()) {
+            addDamage(i, i + 1);
+        }
+    }
+}
+
+/**
+ * Check if a drawn node shows a playing video.
+ */
+bool AminoRenderer::hasPlayingVideos() {
+    std::size_t count = commands.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        amino_render_cmd_t *cmd = &commands[i];
+
+        if (cmd->type != CMD_DRAW) {
+            continue;
+        }
+
+        AminoTexture *texture = getNodeTexture(cmd->node);
+
+        if (texture && texture->isVideoPlaying()) {
+            return true;
+        }
     }
 
+    return false;
+}
+
+/**
+ * Get the texture of a rect or model.
+ */
+AminoTexture* AminoRenderer::getNodeTexture(AminoNode *node) {
+    switch (node->type) {
+        case RECT:
+            {
+                AminoRect *rect = static_cast<AminoRect *>(node);
+
+                if (rect->hasImage) {
+                    return static_cast<AminoTexture *>(rect->propTexture->value);
+                }
+            }
+            break;
+
+        case MODEL:
+            return static_cast<AminoTexture *>(static_cast<AminoModel *>(node)->propTexture->value);
+    }
+
+    return NULL;
+}
+
+/**
+ * Keep the damaged area of the drawn frame.
+ */
+void AminoRenderer::updateDamageHistory() {
+    for (int i = DAMAGE_HISTORY - 1; i > 0; i--) {
+        memcpy(damageHistory[i], damageHistory[i - 1], sizeof damageHistory[i]);
+    }
+
+    memcpy(damageHistory[0], frameDamage, sizeof damageHistory[0]);
+
+    if (damageHistorySize < DAMAGE_HISTORY) {
+        damageHistorySize++;
+    }
+}
+
+/**
+ * Redraw changed areas only.
+ *
+ * Note: needs the age of the back buffer (see updateScene()).
+ */
+void AminoRenderer::setPartialRedraw(bool enabled) {
+    partialRedraw = enabled;
+    damageInvalid = true;
+    damageHistorySize = 0;
+}
+
+/**
+ * Redraw the whole screen on the next cycle.
+ */
+void AminoRenderer::invalidateScene() {
+    damageInvalid = true;
+}
+
+/**
+ * Get the damaged area in window coordinates.
+ *
+ * Returns false if the whole screen is drawn.
+ */
+bool AminoRenderer::getDamageRect(GLint *rect) {
+    if (!damageUsed) {
+        return false;
+    }
+
+    memcpy(rect, damageRect, sizeof damageRect);
+
+    return true;
+}
+
+/**
+ * Update the commands of modified children.
+ *
+ * Returns false if the command list has to be rebuilt.
+ */
+bool AminoRenderer::updateChildCommands(AminoGroup *group) {
+    group->renderChildDirty = false;
+
+    //not recorded
+    if (!group->isVisible() || group->renderCulled) {
+        return true;
+    }
+
+    std::size_t count = group->children.size();
+
+    for (std::size_t i = 0; i < count; i++) {
+        AminoNode *child = group->children[i];
+
+        if (child->renderDirty) {
+            if (!rerecord(child)) {
+                return false;
+            }
+        } else if (child->renderChildDirty) {
+            if (!updateChildCommands(static_cast<AminoGroup *>(child))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Record a modified subtree again.
+ *
+ * Returns false if the number of commands changed.
+ */
+bool AminoRenderer::rerecord(AminoNode *node) {
+    AminoNode *parent = node->parent;
+
+    assert(parent);
+
+    std::size_t index = node->renderCmdIndex;
+    std::size_t count = node->renderCmdCount;
+    int cullCount = node->renderCullCount;
+    GLfloat opacity = parent->renderOpacity * parent->getOpacity();
+    GLfloat clip[4];
+
+    if (static_cast<AminoGroup *>(parent)->propCache->value) {
+        //relative to layer
+        opacity = 1;
+    }
+
+    memcpy(clip, node->renderClip, sizeof clip);
+
+    //old area
+    if (partialRedraw) {
+        addDamage(index, index + count);
+    }
+
+    recordBuffer.clear();
+    record(node, parent->worldMatrix, false, opacity, clip, recordBuffer, index);
+
+    if (recordBuffer.size() != count) {
+        return false;
+    }
+
+    //replace
+    std::copy(recordBuffer.begin(), recordBuffer.end(), commands.begin() + index);
+
+    //new area
+    if (partialRedraw) {
+        addDamage(index, index + count);
+    }
+
+    //update culling stats
+    int diff = node->renderCullCount - cullCount;
+
+    if (diff != 0) {
+        for (AminoNode *item = parent; item; item = item->parent) {
+            item->renderCullCount += diff;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Record the commands of a node and its children.
+ *
+ * The world matrix is only calculated if the local matrix or a parent matrix changed.
+ */
+void AminoRenderer::record(AminoNode *node, GLfloat *parentMatrix, bool parentChanged, GLfloat parentOpacity, GLfloat *clip, std::vector<amino_render_cmd_t> &list, size_t base) {
+    node->renderDirty = false;
+    node->renderChildDirty = false;
+    node->renderCulled = false;
+    node->renderCullCount = 0;
+    node->renderCmdIndex = base + list.size();
+    node->renderCmdCount = 0;
+    memcpy(node->renderClip, clip, sizeof node->renderClip);
+
+    recordCount++;
+
+    bool worldChanged = parentChanged || node->localDirty || !node->worldValid;
+
     //skip non-visible nodes
-    if (!root->propVisible->value) {
+    if (!node->isVisible()) {
+        if (worldChanged) {
+            //calculate once visible
+            node->worldValid = false;
+        }
+
         return;
     }
 
-    ctx->save();
-
     //transform
-    if (root->propW) {
-        //apply origin
-        ctx->translate(root->propW->value* root->propOriginX->value, root->propH->value * root->propOriginY->value);
+    if (worldChanged) {
+        node->updateLocalMatrix();
+
+        //Note: root uses identity matrix
+        bool parentAffine = !node->parent || node->parent->worldAffine;
+
+        if (parentAffine && node->localAffine) {
+            mul_matrix_affine(node->worldMatrix, parentMatrix, node->localMatrix);
+            node->worldAffine = true;
+        } else {
+            mul_matrix(node->worldMatrix, parentMatrix, node->localMatrix);
+            node->worldAffine = false;
+        }
+
+        node->worldValid = true;
+
+        matrixCount++;
     }
 
-    ctx->translate(root->propX->value, root->propY->value, root->propZ->value);
-    ctx->scale(root->propScaleX->value, root->propScaleY->value);
-    ctx->rotate(root->propRotateX->value, root->propRotateY->value, root->propRotateZ->value);
+    node->renderOpacity = parentOpacity;
+
+    //culling
+    GLfloat bounds[4];
+    bool hasBounds = getScreenBounds(node, bounds);
 
-    if (root->propW) {
-        //apply origin
-        ctx->translate(- (root->propW->value* root->propOriginX->value), - (root->propH->value * root->propOriginY->value));
+    node->renderHasBounds = hasBounds;
+
+    if (hasBounds) {
+        memcpy(node->renderBounds, bounds, sizeof node->renderBounds);
     }
 
-    //draw
-    switch (root->type) {
+    if (hasBounds && (bounds[2] < clip[0] || bounds[0] > clip[2] || bounds[3] < clip[1] || bounds[1] > clip[3])) {
+        node->renderCulled = true;
+        node->renderCullCount = 1;
+
+        if (worldChanged && node->type == GROUP) {
+            //children not updated
+            node->worldValid = false;
+        }
+
+        return;
+    }
+
+    //commands
+    if (node->type == GROUP) {
+        AminoGroup *group = static_cast<AminoGroup *>(node);
+        bool useLayer = group->propCache->value;
+        bool useState = group->propDepth->value || group->propClipRect->value;
+
+        if (useLayer) {
+            list.push_back({ CMD_LAYER_BEGIN, node });
+        }
+
+        if (useState) {
+            list.push_back({ CMD_GROUP_BEGIN, node });
+        }
+
+        //clip area of children
+        GLfloat childClip[4];
+
+        memcpy(childClip, clip, sizeof childClip);
+
+        if (useLayer && hasBounds) {
+            //complete layer (independent of screen position)
+            memcpy(childClip, bounds, sizeof childClip);
+        } else if (hasBounds) {
+            childClip[0] = fmax(clip[0], bounds[0]);
+            childClip[1] = fmax(clip[1], bounds[1]);
+            childClip[2] = fmin(clip[2], bounds[2]);
+            childClip[3] = fmin(clip[3], bounds[3]);
+        }
+
+        //Note: layer opacity is applied to the texture
+        GLfloat opacity = useLayer ? 1:parentOpacity * group->getOpacity();
+        std::size_t count = group->children.size();
+
+        for (std::size_t i = 0; i < count; i++) {
+            AminoNode *child = group->children[i];
+
+            record(child, node->worldMatrix, worldChanged, opacity, childClip, list, base);
+            node->renderCullCount += child->renderCullCount;
+        }
+
+        if (useState) {
+            list.push_back({ CMD_GROUP_END, node });
+        }
+
+        if (useLayer) {
+            list.push_back({ CMD_LAYER_END, node });
+        }
+    } else {
+        list.push_back({ CMD_DRAW, node });
+    }
+
+    node->renderCmdCount = base + list.size() - node->renderCmdIndex;
+}
+
+/**
+ * Get the local bounding box of a node (x0, y0, z0, x1, y1, z1).
+ *
+ * Returns false if the node has no known bounds (e.g. group without clipping).
+ */
+bool AminoRenderer::getLocalBounds(AminoNode *node, GLfloat *box) {
+    switch (node->type) {
         case GROUP:
-            this->drawGroup(static_cast<AminoGroup *>(root));
-            break;
+            {
+                AminoGroup *group = static_cast<AminoGroup *>(node);
+
+                if (!group->propClipRect->value && !group->propCache->value) {
+                    return false;
+                }
+            }
+
+            //fall through (clipped)
 
         case RECT:
-            this->drawRect(static_cast<AminoRect *>(root));
-            break;
+            box[0] = 0;
+            box[1] = 0;
+            box[2] = 0;
+            box[3] = node->propW->value;
+            box[4] = node->propH->value;
+            box[5] = 0;
+
+            return true;
 
         case POLY:
-            this->drawPoly(static_cast<AminoPolygon *>(root));
-            break;
+            {
+                AminoPolygon *poly = static_cast<AminoPolygon *>(node);
+
+                //cached (vertices rarely change)
+                if (poly->boundsModified) {
+                    poly->hasBounds = getVertexBounds(poly->propGeometry->value, poly->propDimension->value, poly->bounds);
+                    poly->boundsModified = false;
+                }
+
+                if (!poly->hasBounds) {
+                    return false;
+                }
+
+                memcpy(box, poly->bounds, sizeof poly->bounds);
+            }
+            return true;
 
         case MODEL:
-            this->drawModel(static_cast<AminoModel *>(root));
-            break;
+            {
+                AminoModel *model = static_cast<AminoModel *>(node);
+
+                //cached
+                if (model->boundsModified) {
+                    model->hasBounds = getVertexBounds(model->propVertices->value, 3, model->bounds);
+                    model->boundsModified = false;
+                }
+
+                if (!model->hasBounds) {
+                    return false;
+                }
+
+                memcpy(box, model->bounds, sizeof model->bounds);
+            }
+            return true;
 
         case TEXT:
-            this->drawText(static_cast<AminoText *>(root));
-            break;
+            return getTextBounds(static_cast<AminoText *>(node), box);
 
         default:
-            printf("invalid node type: %i\n", root->type);
-            break;
+            return false;
     }
+}
 
-    //debug
-    if (DEBUG_RENDERER_ERRORS) {
-        showGLErrors();
+/**
+ * Get the bounding box of 2D or 3D vertices (x0, y0, z0, x1, y1, z1).
+ */
+bool AminoRenderer::getVertexBounds(std::vector<float> &vertices, int dim, GLfloat *box) {
+    GLfloat *verts = vertices.data();
+    std::size_t len = vertices.size();
+
+    if (len < (std::size_t)dim || (dim != 2 && dim != 3)) {
+        return false;
+    }
+
+    box[0] = box[3] = verts[0];
+    box[1] = box[4] = verts[1];
+    box[2] = box[5] = dim == 3 ? verts[2]:0;
+
+    for (std::size_t i = dim; i + dim <= len; i += dim) {
+        box[0] = fmin(box[0], verts[i]);
+        box[3] = fmax(box[3], verts[i]);
+        box[1] = fmin(box[1], verts[i + 1]);
+        box[4] = fmax(box[4], verts[i + 1]);
+
+        if (dim == 3) {
+            box[2] = fmin(box[2], verts[i + 2]);
+            box[5] = fmax(box[5], verts[i + 2]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the local bounding box of the laid out glyphs.
+ */
+bool AminoRenderer::getTextBounds(AminoText *text, GLfloat *box) {
+    vertex_buffer_t *buffer = text->buffer;
+
+    if (!buffer || !text->fontSize) {
+        return false;
+    }
+
+    std::size_t count = vector_size(buffer->vertices);
+
+    if (count == 0) {
+        return false;
+    }
+
+    //glyph vertices
+    vertex_t *vertex = (vertex_t *)vector_get(buffer->vertices, 0);
+    GLfloat minX = vertex->x, maxX = vertex->x;
+    GLfloat minY = vertex->y, maxY = vertex->y;
+
+    for (std::size_t i = 1; i < count; i++) {
+        vertex = (vertex_t *)vector_get(buffer->vertices, i);
+
+        minX = fmin(minX, vertex->x);
+        maxX = fmax(maxX, vertex->x);
+        minY = fmin(minY, vertex->y);
+        maxY = fmax(maxY, vertex->y);
+    }
+
+    //apply alignment (flipped y axis)
+    GLfloat x, y;
+
+    getTextOffset(text, x, y);
+
+    box[0] = minX + x;
+    box[1] = - (maxY + y);
+    box[2] = 0;
+    box[3] = maxX + x;
+    box[4] = - (minY + y);
+    box[5] = 0;
+
+    return true;
+}
+
+/**
+ * Get the screen bounds of a node in normalized device coordinates (x0, y0, x1, y1).
+ *
+ * Returns false if the bounds are unknown or the node is partially behind the viewer.
+ */
+bool AminoRenderer::getScreenBounds(AminoNode *node, GLfloat *bounds) {
+    GLfloat box[6];
+
+    if (!getLocalBounds(node, box)) {
+        return false;
+    }
+
+    GLfloat m[16];
+
+    mul_matrix(m, modelView, node->worldMatrix);
+
+    //project all corners
+    for (int i = 0; i < 8; i++) {
+        GLfloat x = box[(i & 1) ? 3:0];
+        GLfloat y = box[(i & 2) ? 4:1];
+        GLfloat z = box[(i & 4) ? 5:2];
+        GLfloat w = m[3] * x + m[7] * y + m[11] * z + m[15];
+
+        if (w <= 0) {
+            return false;
+        }
+
+        GLfloat nx = (m[0] * x + m[4] * y + m[8] * z + m[12]) / w;
+        GLfloat ny = (m[1] * x + m[5] * y + m[9] * z + m[13]) / w;
+
+        if (i == 0) {
+            bounds[0] = bounds[2] = nx;
+            bounds[1] = bounds[3] = ny;
+        } else {
+            bounds[0] = fmin(bounds[0], nx);
+            bounds[1] = fmin(bounds[1], ny);
+            bounds[2] = fmax(bounds[2], nx);
+            bounds[3] = fmax(bounds[3], ny);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Draw the command list.
+ */
+void AminoRenderer::render() {
+    if (DEBUG_RENDERER) {
+        printf("-> render()\n");
+    }
+
+    renderCommands(0, commands.size());
+
+    assert(opacityStack.empty());
+
+    //reset
+    make_identity_matrix(ctx->globaltx);
+    ctx->opacity = 1;
+}
+
+/**
+ * Draw a range of commands.
+ */
+void AminoRenderer::renderCommands(std::size_t start, std::size_t end) {
+    for (std::size_t i = start; i < end; i++) {
+        amino_render_cmd_t *cmd = &commands[i];
+        AminoNode *node = cmd->node;
+
+        //world transform
+        copy_matrix(ctx->globaltx, node->worldMatrix);
+        ctx->opacity = node->renderOpacity * opacityFactor;
+
+        switch (cmd->type) {
+            case CMD_GROUP_BEGIN:
+                this->beginGroup(static_cast<AminoGroup *>(node));
+                continue;
+
+            case CMD_GROUP_END:
+                this->endGroup(static_cast<AminoGroup *>(node));
+                continue;
+
+            case CMD_LAYER_BEGIN:
+                {
+                    AminoGroup *group = static_cast<AminoGroup *>(node);
+                    std::size_t last = node->renderCmdIndex + node->renderCmdCount - 1;
+
+                    assert(last < end);
+                    assert(commands[last].type == CMD_LAYER_END);
+
+                    if (drawLayer(group, i + 1, last)) {
+                        //skip children
+                        i = last;
+                    } else {
+                        //fallback: draw children using the layer opacity
+                        opacityStack.push_back(opacityFactor);
+                        opacityFactor = ctx->opacity * group->getOpacity();
+                    }
+                }
+                continue;
+
+            case CMD_LAYER_END:
+                opacityFactor = opacityStack.back();
+                opacityStack.pop_back();
+                continue;
+        }
+
+        //outside of damaged area
+        if (damageUsed && node->renderHasBounds) {
+            GLfloat *bounds = node->renderBounds;
+
+            if (bounds[2] < damageArea[0] || bounds[0] > damageArea[2] || bounds[3] < damageArea[1] || bounds[1] > damageArea[3]) {
+                continue;
+            }
+        }
+
+        //draw
+        switch (node->type) {
+            case RECT:
+                this->drawRect(static_cast<AminoRect *>(node));
+                break;
+
+            case POLY:
+                this->drawPoly(static_cast<AminoPolygon *>(node));
+                break;
+
+            case MODEL:
+                this->drawModel(static_cast<AminoModel *>(node));
+                break;
+
+            case TEXT:
+                this->drawText(static_cast<AminoText *>(node));
+                break;
+
+            default:
+                printf("invalid node type: %i\n", node->type);
+                break;
+        }
+
+        //debug
+        if (DEBUG_RENDERER_ERRORS) {
+            showGLErrors();
+        }
+    }
+}
+
+/**
+ * Draw a cached group.
+ *
+ * The children are only rendered to the layer texture if a descendant changed.
+ *
+ * Returns false if the group cannot be cached (size, memory budget or transformation).
+ */
+bool AminoRenderer::drawLayer(AminoGroup *group, std::size_t start, std::size_t end) {
+    int w = (int)ceil(group->propW->value);
+    int h = (int)ceil(group->propH->value);
+
+    if (w <= 0 || h <= 0 || w > maxTextureSize || h > maxTextureSize) {
+        return false;
+    }
+
+    //inverse transformation (to layer coordinates)
+    GLfloat inverse[16];
+
+    if (!invert_matrix(group->worldMatrix, inverse)) {
+        return false;
+    }
+
+    //get layer
+    std::map<AminoGroup *, amino_layer_t>::iterator it = layers.find(group);
+
+    if (it != layers.end() && (it->second.w != w || it->second.h != h)) {
+        //size changed
+        freeLayer(it->second);
+        layers.erase(it);
+        it = layers.end();
+    }
+
+    if (it == layers.end()) {
+        amino_layer_t layer;
+
+        if (!createLayer(group, w, h, layer)) {
+            return false;
+        }
+
+        it = layers.insert(std::pair<AminoGroup *, amino_layer_t>(group, layer)).first;
+    }
+
+    amino_layer_t &layer = it->second;
+
+    layer.lastUsed = frameCount;
+
+    //update texture
+    if (!layer.valid || group->layerDirty) {
+        renderLayer(group, layer, inverse, start, end);
+    }
+
+    //draw texture
+    GLfloat verts[6][2];
+
+    verts[0][0] = 0;    verts[0][1] = 0;
+    verts[1][0] = w;    verts[1][1] = 0;
+    verts[2][0] = w;    verts[2][1] = h;
+
+    verts[3][0] = w;    verts[3][1] = h;
+    verts[4][0] = 0;    verts[4][1] = h;
+    verts[5][0] = 0;    verts[5][1] = 0;
+
+    GLfloat texCoords[6][2];
+
+    texCoords[0][0] = 0;    texCoords[0][1] = 0;
+    texCoords[1][0] = 1;    texCoords[1][1] = 0;
+    texCoords[2][0] = 1;    texCoords[2][1] = 1;
+
+    texCoords[3][0] = 1;    texCoords[3][1] = 1;
+    texCoords[4][0] = 0;    texCoords[4][1] = 1;
+    texCoords[5][0] = 0;    texCoords[5][1] = 0;
+
+    GLfloat opacity = ctx->opacity * group->getOpacity();
+
+    applyTextureShader((float *)verts, 2, 6, texCoords, layer.texture, opacity, false, false, false, true);
+
+    return true;
+}
+
+/**
+ * Create the layer texture and framebuffer.
+ *
+ * Older layers are freed if the memory budget is exceeded.
+ */
+bool AminoRenderer::createLayer(AminoGroup *group, int w, int h, amino_layer_t &layer) {
+    //RGBA texture & stencil buffer
+    size_t size = (size_t)w * h * 5;
+
+    if (size > layerBudget) {
+        return false;
+    }
+
+    while (layerMemory + size > layerBudget) {
+        if (!freeOldestLayer()) {
+            return false;
+        }
+    }
+
+    //texture
+    GLuint texture;
+
+    glGenTextures(1, &texture);
+    ctx->bindTexture(texture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    //stencil (clipping)
+    GLuint stencil;
+
+    glGenRenderbuffers(1, &stencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, stencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_STENCIL_INDEX8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    //framebuffer
+    GLint prevFramebuffer;
+    GLuint framebuffer;
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, stencil);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        //retry without stencil buffer
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+        glDeleteRenderbuffers(1, &stencil);
+        stencil = INVALID_BUFFER;
+
+        status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFramebuffer);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        printf("layer framebuffer not supported: %i\n", status);
+
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &texture);
+
+        return false;
+    }
+
+    layer.framebuffer = framebuffer;
+    layer.texture = texture;
+    layer.stencil = stencil;
+    layer.w = w;
+    layer.h = h;
+    layer.size = size;
+    layer.valid = false;
+    layer.lastUsed = frameCount;
+
+    layerMemory += size;
+
+    return true;
+}
+
+/**
+ * Render the children of a group to its layer texture.
+ */
+void AminoRenderer::renderLayer(AminoGroup *group, amino_layer_t &layer, GLfloat *inverse, std::size_t start, std::size_t end) {
+    if (DEBUG_RENDERER) {
+        printf("-> renderLayer()\n");
+    }
+
+    //keep drawing order
+    flushBatch();
+
+    //save state
+    GLint prevFramebuffer;
+    GLfloat prevModelView[16];
+    GLfloat prevViewportW = viewportW;
+    GLfloat prevViewportH = viewportH;
+    bool prevScissorUsed = scissorUsed;
+    GLint prevScissorRect[4];
+    int prevStencilDepth = stencilDepth;
+    bool prevDamageUsed = damageUsed;
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+    copy_matrix(prevModelView, modelView);
+    memcpy(prevScissorRect, scissorRect, sizeof prevScissorRect);
+
+    if (scissorUsed) {
+        glDisable(GL_SCISSOR_TEST);
+        scissorUsed = false;
+    }
+
+    if (stencilDepth > 0) {
+        glDisable(GL_STENCIL_TEST);
+        stencilDepth = 0;
+    }
+
+    //complete layer
+    damageUsed = false;
+
+    //layer target
+    glBindFramebuffer(GL_FRAMEBUFFER, layer.framebuffer);
+    glViewport(0, 0, layer.w, layer.h);
+
+    glClearColor(0, 0, 0, 0);
+    glStencilMask(0xFF);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    glStencilMask(0x00);
+
+    //projection: layer coordinates to texture
+    GLfloat projection[16];
+
+    make_identity_matrix(projection);
+    projection[0] = 2.f / layer.w;
+    projection[5] = 2.f / layer.h;
+    projection[10] = 0;
+    projection[12] = -1;
+    projection[13] = -1;
+
+    mul_matrix(modelView, projection, inverse);
+    viewportW = layer.w;
+    viewportH = layer.h;
+
+    //render children (premultiplied alpha)
+    opacityStack.push_back(opacityFactor);
+    opacityFactor = 1;
+    layerDepth++;
+
+    renderCommands(start, end);
+    flushBatch();
+
+    layerDepth--;
+    opacityFactor = opacityStack.back();
+    opacityStack.pop_back();
+
+    //restore state
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFramebuffer);
+    copy_matrix(modelView, prevModelView);
+    viewportW = prevViewportW;
+    viewportH = prevViewportH;
+    glViewport(0, 0, viewportW, viewportH);
+
+    if (prevScissorUsed) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(prevScissorRect[0], prevScissorRect[1], prevScissorRect[2], prevScissorRect[3]);
+        scissorUsed = true;
+        memcpy(scissorRect, prevScissorRect, sizeof scissorRect);
+    }
+
+    if (prevStencilDepth > 0) {
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_EQUAL, prevStencilDepth, 0xFF);
+        stencilDepth = prevStencilDepth;
+    }
+
+    damageUsed = prevDamageUsed;
+
+    //done
+    group->layerDirty = false;
+    layer.valid = true;
+    layerRenderCount++;
+}
+
+/**
+ * Free the layer's OpenGL resources.
+ */
+void AminoRenderer::freeLayer(amino_layer_t &layer) {
+    glDeleteFramebuffers(1, &layer.framebuffer);
+    glDeleteTextures(1, &layer.texture);
+
+    if (layer.stencil != INVALID_BUFFER) {
+        glDeleteRenderbuffers(1, &layer.stencil);
+    }
+
+    if (ctx && ctx->prevTex == layer.texture) {
+        ctx->prevTex = INVALID_TEXTURE;
+    }
+
+    layerMemory -= layer.size;
+}
+
+/**
+ * Free the least recently used layer.
+ *
+ * Layers used in the current frame are kept (outer layers might be rendering).
+ *
+ * Returns false if there is no other layer.
+ */
+bool AminoRenderer::freeOldestLayer() {
+    std::map<AminoGroup *, amino_layer_t>::iterator oldest = layers.end();
+
+    for (std::map<AminoGroup *, amino_layer_t>::iterator it = layers.begin(); it != layers.end(); it++) {
+        if (it->second.lastUsed == frameCount) {
+            continue;
+        }
+
+        if (oldest == layers.end() || it->second.lastUsed < oldest->second.lastUsed) {
+            oldest = it;
+        }
+    }
+
+    if (oldest == layers.end()) {
+        return false;
+    }
+
+    freeLayer(oldest->second);
+    layers.erase(oldest);
+
+    return true;
+}
+
+/**
+ * Set the memory budget of all cached layers.
+ */
+void AminoRenderer::setLayerBudget(size_t budget) {
+    layerBudget = budget;
+}
+
+/**
+ * Free the layer of a group (destroyed or no longer cached).
+ */
+void AminoRenderer::removeLayer(AminoGroup *group) {
+    std::map<AminoGroup *, amino_layer_t>::iterator it = layers.find(group);
+
+    if (it != layers.end()) {
+        freeLayer(it->second);
+        layers.erase(it);
     }
+}
 
-    //done
-    ctx->restore();
+/**
+ * Set the blend function of translucent content.
+ *
+ * Layer textures store premultiplied colors.
+ */
+void AminoRenderer::applyBlendFunc() {
+    if (layerDepth > 0) {
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
 }
 
 /**
  * Use solid color shader.
  */
 void AminoRenderer::applyColorShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat color[4], GLenum mode) {
+    //keep drawing order
+    flushBatch();
+
     //use shader
     ctx->useShader(colorShader);
 
@@ -429,7 +1593,7 @@ void AminoRenderer::applyColorShader(GLfloat *verts, GLsizei dim, GLsizei count,
 
     if (hasAlpha) {
         glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        applyBlendFunc();
     }
 
     //vertex data
@@ -453,9 +1617,12 @@ void AminoRenderer::applyColorShader(GLfloat *verts, GLsizei dim, GLsizei count,
 /**
  * Draw texture.
  */
-void AminoRenderer::applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat uv[][2], GLuint texId, GLfloat opacity, bool needsClampToBorder, bool repeatX, bool repeatY) {
+void AminoRenderer::applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat uv[][2], GLuint texId, GLfloat opacity, bool needsClampToBorder, bool repeatX, bool repeatY, bool premultiplied) {
     //printf("doing texture shader apply %d opacity = %f\n", texId, opacity);
 
+    //keep drawing order
+    flushBatch();
+
     //use shader
     TextureShader *shader;
 
@@ -480,7 +1647,14 @@ void AminoRenderer::applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei coun
 
     //blend
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (premultiplied) {
+        //color is multiplied by alpha (apply opacity to all channels)
+        glBlendColor(0, 0, 0, opacity);
+        glBlendFuncSeparate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        applyBlendFunc();
+    }
 
     //shader values
     shader->setTransformation(modelView, ctx->globaltx);
@@ -501,95 +1675,234 @@ void AminoRenderer::applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei coun
 }
 
 /**
- * Draw group.
+ * Start drawing a group with depth or clipping.
  */
-void AminoRenderer::drawGroup(AminoGroup *group) {
+void AminoRenderer::beginGroup(AminoGroup *group) {
     if (DEBUG_RENDERER) {
-        printf("-> drawGroup()\n");
+        printf("-> beginGroup()\n");
     }
 
     bool useDepth = group->propDepth->value;
+    bool useClipping = group->propClipRect->value;
+
+    //state changes
+    flushBatch();
 
     if (useDepth) {
         //enable depth mask
         ctx->enableDepth();
     }
 
+    if (useClipping) {
+        beginClipping(group);
+    }
+}
+
+/**
+ * End drawing a group with depth or clipping.
+ */
+void AminoRenderer::endGroup(AminoGroup *group) {
+    if (DEBUG_RENDERER) {
+        printf("-> endGroup()\n");
+    }
+
+    bool useDepth = group->propDepth->value;
+    bool useClipping = group->propClipRect->value;
+
+    //state changes
+    flushBatch();
+
+    if (useClipping) {
+        endClipping(group);
+    }
+
+    if (useDepth) {
+        //disable depth mask again
+        ctx->disableDepth();
+    }
+}
+
+/**
+ * Get the window rectangle of an axis-aligned group (x, y, w, h).
+ *
+ * Returns false if the group is rotated or uses a perspective transformation.
+ */
+bool AminoRenderer::getScissorRect(AminoGroup *group, GLint *rect) {
+    GLfloat m[16];
+
+    mul_matrix(m, modelView, ctx->globaltx);
+
+    //check axis-aligned (no perspective)
+    if (m[3] != 0 || m[7] != 0 || fabs(m[1]) > 1e-6 || fabs(m[4]) > 1e-6 || m[15] <= 0) {
+        return false;
+    }
+
+    //corners in normalized device coordinates
+    GLfloat w = group->propW->value;
+    GLfloat h = group->propH->value;
+    GLfloat x0 = m[12] / m[15];
+    GLfloat y0 = m[13] / m[15];
+    GLfloat x1 = (m[0] * w + m[12]) / m[15];
+    GLfloat y1 = (m[5] * h + m[13]) / m[15];
+
+    //window coordinates
+    GLint left   = (GLint)floor((fmin(x0, x1) + 1) / 2 * viewportW + .5f);
+    GLint right  = (GLint)floor((fmax(x0, x1) + 1) / 2 * viewportW + .5f);
+    GLint bottom = (GLint)floor((fmin(y0, y1) + 1) / 2 * viewportH + .5f);
+    GLint top    = (GLint)floor((fmax(y0, y1) + 1) / 2 * viewportH + .5f);
+
+    rect[0] = left;
+    rect[1] = bottom;
+    rect[2] = right - left;
+    rect[3] = top - bottom;
+
+    return true;
+}
+
+/**
+ * Start clipping to the group's rectangle.
+ *
+ * Axis-aligned groups use the scissor test, all others the stencil buffer.
+ */
+void AminoRenderer::beginClipping(AminoGroup *group) {
+    amino_clip_t clip;
+    GLint rect[4];
+
+    clip.stencil = !getScissorRect(group, rect);
+
+    //keep outer scissor area
+    clip.scissor = scissorUsed;
+    memcpy(clip.rect, scissorRect, sizeof clip.rect);
+
+    clipStack.push_back(clip);
+
+    if (!clip.stencil) {
+        //intersect with outer area
+        if (scissorUsed) {
+            GLint left   = std::max(rect[0], scissorRect[0]);
+            GLint bottom = std::max(rect[1], scissorRect[1]);
+            GLint right  = std::min(rect[0] + rect[2], scissorRect[0] + scissorRect[2]);
+            GLint top    = std::min(rect[1] + rect[3], scissorRect[1] + scissorRect[3]);
+
+            rect[0] = left;
+            rect[1] = bottom;
+            rect[2] = std::max(right - left, 0);
+            rect[3] = std::max(top - bottom, 0);
+        }
+
+        if (!scissorUsed) {
+            glEnable(GL_SCISSOR_TEST);
+            scissorUsed = true;
+        }
+
+        memcpy(scissorRect, rect, sizeof scissorRect);
+        glScissor(rect[0], rect[1], rect[2], rect[3]);
+
+        scissorCount++;
+
+        return;
+    }
+
     /*
-     * Clipping:
+     * Stencil clipping:
      *
      *  - quite slow on Raspberry Pi!
+     *  - nested levels are counted in the stencil buffer
      */
-    bool useClipping = group->propClipRect->value;
+    stencilDepth++;
+    stencilCount++;
 
-    if (useClipping) {
+    if (stencilDepth == 1) {
         //turn on stenciling
         glEnable(GL_STENCIL_TEST);
 
-        //setup the stencil
-        glStencilFunc(GL_ALWAYS, 0x1, 0xFF);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        //clear the buffer
         glStencilMask(0xFF);
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-
-        //clear the buffers
         glClear(GL_STENCIL_BUFFER_BIT);
+    }
 
-        //draw the stencil
-        float x = 0;
-        float y = 0;
-        float x2 = group->propW->value;
-        float y2 = group->propH->value;
-        GLfloat verts[6][2];
+    //increment inside the outer area
+    glStencilFunc(GL_EQUAL, stencilDepth - 1, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    drawStencil(group);
 
-        verts[0][0] = x;
-        verts[0][1] = y;
-        verts[1][0] = x2;
-        verts[1][1] = y;
-        verts[2][0] = x2;
-        verts[2][1] = y2;
+    //set function to draw pixels inside the current level
+    glStencilFunc(GL_EQUAL, stencilDepth, 0xFF);
+}
 
-        verts[3][0] = x2;
-        verts[3][1] = y2;
-        verts[4][0] = x;
-        verts[4][1] = y2;
-        verts[5][0] = x;
-        verts[5][1] = y;
+/**
+ * End clipping.
+ */
+void AminoRenderer::endClipping(AminoGroup *group) {
+    assert(!clipStack.empty());
 
-        GLfloat color[4] = { 1.0, 1.0, 1.0, 1.0 };
+    amino_clip_t clip = clipStack.back();
 
-        applyColorShader((float *)verts, 2, 6, color);
+    clipStack.pop_back();
 
-        //set function to draw pixels where the buffer is equal to 1
-        glStencilFunc(GL_EQUAL, 0x1, 0xFF);
-        glStencilMask(0x00);
+    if (!clip.stencil) {
+        //restore outer scissor area
+        if (clip.scissor) {
+            memcpy(scissorRect, clip.rect, sizeof scissorRect);
+            glScissor(scissorRect[0], scissorRect[1], scissorRect[2], scissorRect[3]);
+        } else {
+            glDisable(GL_SCISSOR_TEST);
+            scissorUsed = false;
+        }
 
-        //turn color buffer drawing back on
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        return;
     }
 
-    //group opacity
-    ctx->saveOpacity();
-    ctx->applyOpacity(group->propOpacity->value);
+    assert(stencilDepth > 0);
 
-    //render items
-    std::size_t count = group->children.size();
+    if (stencilDepth == 1) {
+        glDisable(GL_STENCIL_TEST);
+    } else {
+        //decrement the current level
+        glStencilOp(GL_KEEP, GL_KEEP, GL_DECR);
+        drawStencil(group);
 
-    for (std::size_t i = 0; i < count; i++) {
-        this->render(group->children[i]);
+        glStencilFunc(GL_EQUAL, stencilDepth - 1, 0xFF);
     }
 
-    //restore opacity
-    ctx->restoreOpacity();
+    stencilDepth--;
+}
 
-    if (useClipping) {
-        glDisable(GL_STENCIL_TEST);
-    }
+/**
+ * Draw the group's rectangle to the stencil buffer.
+ */
+void AminoRenderer::drawStencil(AminoGroup *group) {
+    glStencilMask(0xFF);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+    //draw the stencil
+    float x = 0;
+    float y = 0;
+    float x2 = group->propW->value;
+    float y2 = group->propH->value;
+    GLfloat verts[6][2];
 
-    if (useDepth) {
-        //disable depth mask again
-        ctx->disableDepth();
-    }
+    verts[0][0] = x;
+    verts[0][1] = y;
+    verts[1][0] = x2;
+    verts[1][1] = y;
+    verts[2][0] = x2;
+    verts[2][1] = y2;
+
+    verts[3][0] = x2;
+    verts[3][1] = y2;
+    verts[4][0] = x;
+    verts[4][1] = y2;
+    verts[5][0] = x;
+    verts[5][1] = y;
+
+    GLfloat color[4] = { 1.0, 1.0, 1.0, 1.0 };
+
+    applyColorShader((float *)verts, 2, 6, color);
+
+    //turn color buffer drawing back on
+    glStencilMask(0x00);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 }
 
 /**
@@ -604,10 +1917,43 @@ void AminoRenderer::drawPoly(AminoPolygon *poly) {
     std::vector<float> *geometry = &poly->propGeometry->value;
     int len = geometry->size();
     int dim = poly->propDimension->value;
-    GLfloat *verts = geometry->data();
 
     assert(dim == 2 || dim == 3);
 
+    if (len == 0) {
+        return;
+    }
+
+    //keep drawing order (before binding our buffer)
+    flushBatch();
+
+    //VBO
+    if (poly->vboGeometry == INVALID_BUFFER) {
+        glGenBuffers(1, &poly->vboGeometry);
+        poly->vboGeometryModified = true;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, poly->vboGeometry);
+
+    GLsizeiptr size = sizeof(GLfloat) * len;
+
+    if (poly->vboGeometryModified || size != poly->vboGeometrySize) {
+        //full upload
+        uploadBuffer(GL_ARRAY_BUFFER, size, geometry->data(), poly->vboGeometrySize);
+    } else if (poly->geometryRangeStart < poly->geometryRangeEnd) {
+        //modified range
+        std::size_t start = poly->geometryRangeStart;
+        std::size_t end = std::min(poly->geometryRangeEnd, geometry->size());
+
+        if (start < end) {
+            uploadBufferRange(GL_ARRAY_BUFFER, sizeof(GLfloat) * start, sizeof(GLfloat) * (end - start), geometry->data() + start);
+        }
+    }
+
+    poly->vboGeometryModified = false;
+    poly->geometryRangeStart = 0;
+    poly->geometryRangeEnd = 0;
+
     //draw
     GLenum mode;
 
@@ -619,16 +1965,46 @@ void AminoRenderer::drawPoly(AminoPolygon *poly) {
         mode = GL_LINE_LOOP;
     }
 
-    GLfloat opacity = poly->propOpacity->value * ctx->opacity;
+    GLfloat opacity = poly->getOpacity() * ctx->opacity;
     GLfloat color[4] = { poly->propFillR->value, poly->propFillG->value, poly->propFillB->value, opacity };
 
-    applyColorShader(verts, dim, len / dim, color, mode);
+    applyColorShader(NULL, dim, len / dim, color, mode);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * Upload buffer data.
+ *
+ * Note: keeps the existing storage if the size did not change.
+ */
+void AminoRenderer::uploadBuffer(GLenum target, GLsizeiptr size, const GLvoid *data, GLsizeiptr &bufferSize) {
+    if (size == bufferSize) {
+        glBufferSubData(target, 0, size, data);
+    } else {
+        glBufferData(target, size, data, GL_STATIC_DRAW);
+        bufferSize = size;
+    }
+
+    uploadBytes += size;
+}
+
+/**
+ * Upload part of the buffer data.
+ */
+void AminoRenderer::uploadBufferRange(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data) {
+    glBufferSubData(target, offset, size, data);
+
+    uploadBytes += size;
 }
 
 /**
  * Draw 3D model.
  */
 void AminoRenderer::drawModel(AminoModel *model) {
+    //keep drawing order
+    flushBatch();
+
     //check rendering mode
 
     // 1) vertices
@@ -652,7 +2028,7 @@ void AminoRenderer::drawModel(AminoModel *model) {
 
         if (model->vboIndexModified) {
             model->vboIndexModified = false;
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort) * vecIndices->size(), vecIndices->data(), GL_STATIC_DRAW);
+            uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort) * vecIndices->size(), vecIndices->data(), model->vboIndexSize);
         }
     }
 
@@ -692,7 +2068,7 @@ void AminoRenderer::drawModel(AminoModel *model) {
 
         if (model->vboNormalModified) {
             model->vboNormalModified = false;
-            glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecNormals->size(), vecNormals->data(), GL_STATIC_DRAW);
+            uploadBuffer(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecNormals->size(), vecNormals->data(), model->vboNormalSize);
         }
 
         //get shader
@@ -749,7 +2125,7 @@ void AminoRenderer::drawModel(AminoModel *model) {
 
     //color shader
     if (colorShader) {
-        GLfloat opacity = model->propOpacity->value * ctx->opacity;
+        GLfloat opacity = model->getOpacity() * ctx->opacity;
         GLfloat color[4] = { model->propFillR->value, model->propFillG->value, model->propFillB->value, opacity };
 
         colorShader->setColor(color);
@@ -768,13 +2144,13 @@ void AminoRenderer::drawModel(AminoModel *model) {
 
         if (model->vboUVModified) {
             model->vboUVModified = false;
-            glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecUVs->size(), vecUVs->data(), GL_STATIC_DRAW);
+            uploadBuffer(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecUVs->size(), vecUVs->data(), model->vboUVSize);
         }
 
         textureShader->setTextureCoordinates(NULL);
 
         //opacity
-        GLfloat opacity = model->propOpacity->value * ctx->opacity;
+        GLfloat opacity = model->getOpacity() * ctx->opacity;
 
         textureShader->setOpacity(opacity);
         hasAlpha = opacity != 1.0;
@@ -789,7 +2165,7 @@ void AminoRenderer::drawModel(AminoModel *model) {
     //alpha
     if (hasAlpha) {
         glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        applyBlendFunc();
     }
 
     //vertices
@@ -802,7 +2178,7 @@ void AminoRenderer::drawModel(AminoModel *model) {
 
     if (model->vboVertexModified) {
         model->vboVertexModified = false;
-        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecVertices->size(), vecVertices->data(), GL_STATIC_DRAW);
+        uploadBuffer(GL_ARRAY_BUFFER, sizeof(GLfloat) * vecVertices->size(), vecVertices->data(), model->vboVertexSize);
     }
 
     shader->setVertexData(3, NULL);
@@ -848,31 +2224,9 @@ void AminoRenderer::drawRect(AminoRect *rect) {
         printf("-> drawRect() hasImage=%s\n", rect->hasImage ? "true":"false");
     }
 
-    ctx->save();
-
-    //two triangles
-    float x =  0;
-    float y =  0;
-    float x2 = rect->propW->value;
-    float y2 = rect->propH->value;
-
-    GLfloat verts[6][2];
-
-    verts[0][0] = x;
-    verts[0][1] = y;
-    verts[1][0] = x2;
-    verts[1][1] = y;
-    verts[2][0] = x2;
-    verts[2][1] = y2;
-
-    verts[3][0] = x2;
-    verts[3][1] = y2;
-    verts[4][0] = x;
-    verts[4][1] = y2;
-    verts[5][0] = x;
-    verts[5][1] = y;
-
-    GLfloat opacity = rect->propOpacity->value * ctx->opacity;
+    GLfloat w = rect->propW->value;
+    GLfloat h = rect->propH->value;
+    GLfloat opacity = rect->getOpacity() * ctx->opacity;
 
     if (rect->hasImage) {
         //has optional texture
@@ -885,20 +2239,11 @@ void AminoRenderer::drawRect(AminoRect *rect) {
             //printf("texture: %i\n", texture->textureId);
 
             //image coordinates (fractional world coordinates)
-            GLfloat texCoords[6][2];
             float tx  = rect->propLeft->value;   //0
             float ty2 = rect->propBottom->value; //1
             float tx2 = rect->propRight->value;  //1
             float ty  = rect->propTop->value;    //0
 
-            texCoords[0][0] = tx;    texCoords[0][1] = ty;
-            texCoords[1][0] = tx2;   texCoords[1][1] = ty;
-            texCoords[2][0] = tx2;   texCoords[2][1] = ty2;
-
-            texCoords[3][0] = tx2;   texCoords[3][1] = ty2;
-            texCoords[4][0] = tx;    texCoords[4][1] = ty2;
-            texCoords[5][0] = tx;    texCoords[5][1] = ty;
-
             //check clamp to border
             bool needsClampToBorder = (tx < 0 || tx > 1) || (tx2 < 0 || tx2 > 1) || (ty < 0 || ty > 1) || (ty2 < 0 || ty2 > 1) || rect->repeatX || rect->repeatY;
 
@@ -906,52 +2251,204 @@ void AminoRenderer::drawRect(AminoRect *rect) {
             //if (needsClampToBorder) printf("needsClampToBorder\n");
 
             texture->prepareTexture(ctx);
-            applyTextureShader((float *)verts, 2, 6, texCoords, texture->getTexture(), opacity, needsClampToBorder, rect->repeatX, rect->repeatY);
+
+            if (needsClampToBorder) {
+                //not batched
+                GLfloat verts[6][2];
+
+                verts[0][0] = 0;    verts[0][1] = 0;
+                verts[1][0] = w;    verts[1][1] = 0;
+                verts[2][0] = w;    verts[2][1] = h;
+
+                verts[3][0] = w;    verts[3][1] = h;
+                verts[4][0] = 0;    verts[4][1] = h;
+                verts[5][0] = 0;    verts[5][1] = 0;
+
+                GLfloat texCoords[6][2];
+
+                texCoords[0][0] = tx;    texCoords[0][1] = ty;
+                texCoords[1][0] = tx2;   texCoords[1][1] = ty;
+                texCoords[2][0] = tx2;   texCoords[2][1] = ty2;
+
+                texCoords[3][0] = tx2;   texCoords[3][1] = ty2;
+                texCoords[4][0] = tx;    texCoords[4][1] = ty2;
+                texCoords[5][0] = tx;    texCoords[5][1] = ty;
+
+                applyTextureShader((float *)verts, 2, 6, texCoords, texture->getTexture(), opacity, needsClampToBorder, rect->repeatX, rect->repeatY);
+            } else {
+                GLfloat values[4] = { opacity, 0, 0, 0 };
+                GLfloat uv[4] = { tx, ty, tx2, ty2 };
+
+                addBatchRect(BATCH_TEXTURE, texture->getTexture(), true, w, h, values, uv);
+            }
         }
     } else {
         //color only
         GLfloat color[4] = { rect->propR->value, rect->propG->value, rect->propB->value, opacity };
 
-        applyColorShader((float *)verts, 2, 6, color);
+        addBatchRect(BATCH_COLOR, INVALID_TEXTURE, opacity != 1.0, w, h, color, NULL);
     }
-
-    ctx->restore();
 }
 
 /**
- * Render text.
+ * Add a rect to the current batch.
+ *
+ * The vertices are transformed on the CPU. The batch is drawn if the shader, texture or blend state changes.
+ *
+ * @param values color (RGBA) or opacity (first value).
+ * @param uv texture coordinates (left, top, right, bottom).
  */
-void AminoRenderer::drawText(AminoText *text) {
-    if (DEBUG_RENDERER) {
-        printf("-> drawText()\n");
+void AminoRenderer::addBatchRect(int mode, GLuint texture, bool blend, GLfloat w, GLfloat h, GLfloat values[4], GLfloat uv[4]) {
+    //check state
+    if (batchMode != mode || batchTexture != texture || batchBlend != blend) {
+        flushBatch();
+
+        batchMode = mode;
+        batchTexture = texture;
+        batchBlend = blend;
+    }
+
+    GLsizei stride = mode == BATCH_COLOR ? BatchColorShader::STRIDE : BatchTextureShader::STRIDE;
+
+    if (batchVertices.size() / stride + 6 > BATCH_MAX_VERTICES) {
+        flushBatch();
+
+        batchMode = mode;
+        batchTexture = texture;
+        batchBlend = blend;
+    }
+
+    //corners (two triangles)
+    GLfloat corners[6][2] = {
+        { 0, 0 }, { w, 0 }, { w, h },
+        { w, h }, { 0, h }, { 0, 0 }
+    };
+
+    GLfloat texCoords[6][2];
+
+    if (uv) {
+        GLfloat tx = uv[0], ty = uv[1], tx2 = uv[2], ty2 = uv[3];
+
+        texCoords[0][0] = tx;    texCoords[0][1] = ty;
+        texCoords[1][0] = tx2;   texCoords[1][1] = ty;
+        texCoords[2][0] = tx2;   texCoords[2][1] = ty2;
+
+        texCoords[3][0] = tx2;   texCoords[3][1] = ty2;
+        texCoords[4][0] = tx;    texCoords[4][1] = ty2;
+        texCoords[5][0] = tx;    texCoords[5][1] = ty;
     }
 
-    //get texture
-    GLuint texture = text->getTextureId();
+    //transform to world coordinates
+    GLfloat *m = ctx->globaltx;
+
+    for (int i = 0; i < 6; i++) {
+        GLfloat x = corners[i][0];
+        GLfloat y = corners[i][1];
+
+        batchVertices.push_back(m[0] * x + m[4] * y + m[12]);
+        batchVertices.push_back(m[1] * x + m[5] * y + m[13]);
+        batchVertices.push_back(m[2] * x + m[6] * y + m[14]);
+        batchVertices.push_back(m[3] * x + m[7] * y + m[15]);
+
+        if (mode == BATCH_COLOR) {
+            batchVertices.push_back(values[0]);
+            batchVertices.push_back(values[1]);
+            batchVertices.push_back(values[2]);
+            batchVertices.push_back(values[3]);
+        } else {
+            batchVertices.push_back(texCoords[i][0]);
+            batchVertices.push_back(texCoords[i][1]);
+            batchVertices.push_back(values[0]);
+        }
+    }
+
+    batchNodeCount++;
+}
+
+/**
+ * Draw all batched vertices.
+ */
+void AminoRenderer::flushBatch() {
+    if (batchMode == BATCH_NONE) {
+        return;
+    }
 
-    if (texture == INVALID_TEXTURE) {
+    if (batchVertices.empty()) {
+        batchMode = BATCH_NONE;
         return;
     }
 
-    ctx->save();
+    //upload (orphan previous buffer)
+    GLsizeiptr size = batchVertices.size() * sizeof(GLfloat);
 
-    //flip the y axis
-    ctx->scale(1, -1);
+    glBindBuffer(GL_ARRAY_BUFFER, batchBuffer);
+    glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, batchVertices.data());
+
+    //blend
+    if (batchBlend) {
+        glEnable(GL_BLEND);
+        applyBlendFunc();
+    }
+
+    //draw (Note: trans uniform is not used)
+    if (batchMode == BATCH_COLOR) {
+        ctx->useShader(batchColorShader);
+
+        batchColorShader->setTransformation(modelView, ctx->globaltx);
+        batchColorShader->setBatchData();
+        batchColorShader->drawTriangles(batchVertices.size() / BatchColorShader::STRIDE, GL_TRIANGLES);
+    } else {
+        ctx->useShader(batchTextureShader);
+
+        //Note: always bind (video players bind textures directly)
+        glBindTexture(GL_TEXTURE_2D, batchTexture);
+        ctx->prevTex = batchTexture;
 
+        batchTextureShader->setTransformation(modelView, ctx->globaltx);
+        batchTextureShader->setBatchData();
+        batchTextureShader->drawTriangles(batchVertices.size() / BatchTextureShader::STRIDE, GL_TRIANGLES);
+    }
+
+    //cleanup
+    if (batchBlend) {
+        glDisable(GL_BLEND);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    batchVertices.clear();
+    batchMode = BATCH_NONE;
+    batchCount++;
+}
+
+/**
+ * Get the text alignment offset (flipped y axis).
+ */
+void AminoRenderer::getTextOffset(AminoText *text, GLfloat &x, GLfloat &y) {
     //baseline at top/left
     texture_font_t *tf = text->fontSize->fontTexture;
 
     //debug
     //sprintf("font: size=%f height=%f ascender=%f descender=%f\n", tf->size, tf->height, tf->ascender, tf->descender);
 
+    //metrics (scaled for SDF fonts)
+    GLfloat scale = text->fontSize->scale;
+    GLfloat ascender = tf->ascender * scale;
+    GLfloat descender = tf->descender * scale;
+    GLfloat height = tf->height * scale;
+
+    x = 0;
+    y = 0;
+
     //horizontal alignment
     switch (text->align) {
         case AminoText::ALIGN_CENTER:
-            ctx->translate((text->propW->value - text->lineW) / 2, 0);
+            x = (text->propW->value - text->lineW) / 2;
             break;
 
         case AminoText::ALIGN_RIGHT:
-            ctx->translate(text->propW->value - text->lineW, 0);
+            x = text->propW->value - text->lineW;
             break;
 
         case AminoText::ALIGN_LEFT:
@@ -962,21 +2459,49 @@ void AminoRenderer::drawText(AminoText *text) {
     //vertical alignment
     switch (text->vAlign) {
         case AminoText::VALIGN_TOP:
-            ctx->translate(0, -tf->ascender);
+            y = -ascender;
             break;
 
         case AminoText::VALIGN_BOTTOM:
-            ctx->translate(0, - text->propH->value - tf->descender + (text->lineNr - 1) * tf->height);
+            y = - text->propH->value - descender + (text->lineNr - 1) * height;
             break;
 
         case AminoText::VALIGN_MIDDLE:
-            ctx->translate(0, - tf->ascender - (text->propH->value - text->lineNr * tf->height) / 2);
+            y = - ascender - (text->propH->value - text->lineNr * height) / 2;
             break;
 
         case AminoText::VALIGN_BASELINE:
         default:
             break;
     }
+}
+
+/**
+ * Render text.
+ */
+void AminoRenderer::drawText(AminoText *text) {
+    if (DEBUG_RENDERER) {
+        printf("-> drawText()\n");
+    }
+
+    if (text->atlasRanges.empty() || !text->buffer) {
+        //layout not ready
+        return;
+    }
+
+    //keep drawing order
+    flushBatch();
+
+    ctx->save();
+
+    //flip the y axis
+    ctx->scale(1, -1);
+
+    //alignment
+    GLfloat x, y;
+
+    getTextOffset(text, x, y);
+    ctx->translate(x, y);
 
     //use texture
     if (DEBUG_RENDERER_ERRORS) {
@@ -984,28 +2509,44 @@ void AminoRenderer::drawText(AminoText *text) {
     }
 
     glActiveTexture(GL_TEXTURE0);
-    ctx->bindTexture(texture);
 
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    applyBlendFunc();
 
     //font shader
-    ctx->useShader(fontShader);
+    AminoFontShader *shader = text->fontSize->font->sdf ? sdfFontShader:fontShader;
+
+    ctx->useShader(shader);
 
     //color & opacity
-    fontShader->setTransformation(modelView, ctx->globaltx);
-    fontShader->setOpacity(ctx->opacity * text->propOpacity->value);
+    shader->setTransformation(modelView, ctx->globaltx);
+    shader->setOpacity(ctx->opacity * text->getOpacity());
 
     GLfloat color[3] = { text->propR->value, text->propG->value, text->propB->value };
 
-    fontShader->setColor(color);
+    shader->setColor(color);
+
+    if (shader == sdfFontShader) {
+        //one pixel on screen (Note: projection and viewport scaling ignored)
+        GLfloat *m = ctx->globaltx;
+        GLfloat scale = sqrt(m[0] * m[0] + m[1] * m[1]) * text->fontSize->scale;
+
+        sdfFontShader->setSmoothing(std::min(0.25f / (SDF_SPREAD * scale), 0.5f));
+    }
 
     if (DEBUG_RENDERER_ERRORS) {
         showGLErrors("before text rendering");
     }
 
-    //render
-    vertex_buffer_render(text->buffer, GL_TRIANGLES);
+    //render (one draw call per atlas page)
+    vertex_buffer_render_setup(text->buffer, GL_TRIANGLES);
+
+    for (auto const &range : text->atlasRanges) {
+        ctx->bindTexture(range.textureId);
+        glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_SHORT, (void *)(range.start * sizeof(GLushort)));
+    }
+
+    vertex_buffer_render_finish(text->buffer);
 
     if (DEBUG_RENDERER_ERRORS) {
         showGLErrors("after text rendering");
@@ -1034,6 +2575,39 @@ amino_atlas_t AminoRenderer::getAtlasTexture(texture_atlas_t *atlas, bool create
     return res;
 }
 
+/**
+ * Get renderer statistics (last frame).
+ */
+void AminoRenderer::getStats(v8::Local<v8::Object> &obj) {
+    Nan::Set(obj, Nan::New("batches").ToLocalChecked(), Nan::New(lastBatchCount));
+    Nan::Set(obj, Nan::New("batchedNodes").ToLocalChecked(), Nan::New(lastBatchNodeCount));
+
+    //command list
+    Nan::Set(obj, Nan::New("commands").ToLocalChecked(), Nan::New((double)commands.size()));
+    Nan::Set(obj, Nan::New("recordedNodes").ToLocalChecked(), Nan::New(lastRecordCount));
+    Nan::Set(obj, Nan::New("commandRebuilds").ToLocalChecked(), Nan::New(rebuildCount));
+    Nan::Set(obj, Nan::New("matrixUpdates").ToLocalChecked(), Nan::New(lastMatrixCount));
+
+    //culling
+    Nan::Set(obj, Nan::New("culledNodes").ToLocalChecked(), Nan::New(lastRoot ? lastRoot->renderCullCount:0));
+
+    //clipping
+    Nan::Set(obj, Nan::New("scissorClips").ToLocalChecked(), Nan::New(lastScissorCount));
+    Nan::Set(obj, Nan::New("stencilClips").ToLocalChecked(), Nan::New(lastStencilCount));
+
+    //layers
+    Nan::Set(obj, Nan::New("layers").ToLocalChecked(), Nan::New((double)layers.size()));
+    Nan::Set(obj, Nan::New("layerMemory").ToLocalChecked(), Nan::New((double)layerMemory));
+    Nan::Set(obj, Nan::New("layersRendered").ToLocalChecked(), Nan::New(lastLayerRenderCount));
+
+    //buffers
+    Nan::Set(obj, Nan::New("uploadBytes").ToLocalChecked(), Nan::New((double)lastUploadBytes));
+
+    //partial redraw
+    Nan::Set(obj, Nan::New("skippedFrames").ToLocalChecked(), Nan::New(skippedFrames));
+    Nan::Set(obj, Nan::New("damageRatio").ToLocalChecked(), Nan::New(lastDamageRatio));
+}
+
 /**
  * Output all occured OpenGL errors.
  */
@@ -5,17 +5,75 @@
 
 #include "mathutils.h"
 
-#include <stack>
+#include <algorithm>
+#include <cfloat>
+
+//batch modes
+const int BATCH_NONE    = 0;
+const int BATCH_COLOR   = 1;
+const int BATCH_TEXTURE = 2;
+
+//matrix stack size (preallocated)
+#define MATRIX_STACK_SIZE 16
+
+//render commands
+const int CMD_DRAW        = 0;
+const int CMD_GROUP_BEGIN = 1;
+const int CMD_GROUP_END   = 2;
+const int CMD_LAYER_BEGIN = 3;
+const int CMD_LAYER_END   = 4;
+
+//default layer cache budget (bytes)
+#define LAYER_BUDGET (32 * 1024 * 1024)
+
+//partial redraw (damage of previous frames)
+#define DAMAGE_HISTORY 4
+
+/**
+ * Cached group layer (render to texture).
+ */
+typedef struct {
+    GLuint framebuffer;
+    GLuint texture;
+    GLuint stencil;
+    int w;
+    int h;
+    size_t size;
+    bool valid;
+    int lastUsed;
+} amino_layer_t;
+
+/**
+ * Clipping state of a group.
+ */
+typedef struct {
+    bool stencil;
+
+    //outer scissor area
+    bool scissor;
+    GLint rect[4];
+} amino_clip_t;
+
+/**
+ * Recorded draw operation (world matrix and opacity are cached in the node).
+ */
+typedef struct {
+    int type;
+    AminoNode *node;
+} amino_render_cmd_t;
 
 /**
  * Rendering context.
  */
 class GLContext {
 public:
-    std::stack<void *> matrixStack;
-    GLfloat *globaltx = new GLfloat[16];
+    GLfloat globaltx[16];
     GLfloat opacity = 1;
 
+    //matrix stack (arena)
+    GLfloat matrixStack[MATRIX_STACK_SIZE * 16];
+    int matrixStackSize = 0;
+
     int depth = 0;
 
     AnyAminoShader *prevShader = NULL;
@@ -33,15 +91,14 @@ public:
      * Destructor.
      */
     virtual ~GLContext() {
-        assert(matrixStack.empty());
-        delete[] globaltx;
+        assert(matrixStackSize == 0);
     }
 
     /**
      * Reset context (prepare for next cycle).
      */
     void reset() {
-        assert(matrixStack.empty());
+        assert(matrixStackSize == 0);
         assert(depth == 0);
 
         //reset
@@ -78,12 +135,10 @@ public:
      * Translate x/y/z.
      */
     void translate(GLfloat x, GLfloat y, GLfloat z) {
-        GLfloat tr[16];
-        GLfloat trans2[16];
-
-        make_trans_matrix(x, y, z, tr);
-        mul_matrix(trans2, globaltx, tr);
-        copy_matrix(globaltx, trans2);
+        //last column (no full multiplication needed)
+        for (int i = 0; i < 4; i++) {
+            globaltx[12 + i] += globaltx[i] * x + globaltx[4 + i] * y + globaltx[8 + i] * z;
+        }
     }
 
     /**
@@ -93,89 +148,55 @@ public:
      */
     void rotate(GLfloat x, GLfloat y, GLfloat z) {
         GLfloat rot[16];
-        GLfloat temp[16];
 
         //x-rotation
-        make_x_rot_matrix(x, rot);
-        mul_matrix(temp, globaltx, rot);
-        copy_matrix(globaltx, temp);
+        if (x != 0) {
+            make_x_rot_matrix(x, rot);
+            mul_matrix(globaltx, globaltx, rot);
+        }
 
         //y-rotation
-        make_y_rot_matrix(y, rot);
-        mul_matrix(temp, globaltx, rot);
-        copy_matrix(globaltx, temp);
+        if (y != 0) {
+            make_y_rot_matrix(y, rot);
+            mul_matrix(globaltx, globaltx, rot);
+        }
 
         //z-rotation
-        make_z_rot_matrix(z, rot);
-        mul_matrix(temp, globaltx, rot);
-        copy_matrix(globaltx, temp);
+        if (z != 0) {
+            make_z_rot_matrix(z, rot);
+            mul_matrix(globaltx, globaltx, rot);
+        }
     }
 
     /**
      * Scale in x und y directions.
      */
     void scale(GLfloat x, GLfloat y) {
-        GLfloat scale[16];
-        GLfloat temp[16];
-
-        make_scale_matrix(x, y, 1.0, scale);
-        mul_matrix(temp, globaltx, scale);
-        copy_matrix(globaltx, temp);
-    }
-
-    /**
-     * Set opacity value.
-     */
-    GLfloat applyOpacity(GLfloat opacity) {
-        this->opacity *= opacity;
-
-        return this->opacity;
-    }
-
-    /**
-     * Save opacity.
-     */
-    void saveOpacity() {
-        GLfloat *temp = new GLfloat[1];
-
-        temp[0] = opacity;
-        matrixStack.push(temp);
-    }
-
-    /**
-     * Restore the opacity.
-     */
-    void restoreOpacity() {
-        GLfloat *temp = (GLfloat *)matrixStack.top();
-
-        matrixStack.pop();
-
-        opacity = temp[0];
-        delete[] temp;
+        //first two columns
+        for (int i = 0; i < 4; i++) {
+            globaltx[i] *= x;
+            globaltx[4 + i] *= y;
+        }
     }
 
     /**
      * Save matrix.
      */
     void save() {
-        //matrix
-        GLfloat *temp = new GLfloat[16];
+        assert(matrixStackSize < MATRIX_STACK_SIZE);
 
-        copy_matrix(temp, globaltx);
-        matrixStack.push(globaltx);
-        globaltx = temp;
+        copy_matrix(matrixStack + matrixStackSize * 16, globaltx);
+        matrixStackSize++;
     }
 
     /**
      * Restore matrix.
      */
     void restore() {
-        //matrix
-        delete[] globaltx;
-        globaltx = (GLfloat *)matrixStack.top();
-        matrixStack.pop();
+        assert(matrixStackSize > 0);
 
-        assert(globaltx);
+        matrixStackSize--;
+        copy_matrix(globaltx, matrixStack + matrixStackSize * 16);
     }
 
     /**
@@ -274,30 +295,47 @@ public:
     virtual void setupPerspective(v8::Local<v8::Object> &perspective);
 
     virtual void updateViewport(GLfloat width, GLfloat height, GLfloat viewportW, GLfloat viewportH);
+    virtual bool updateScene(AminoNode *node, int bufferAge);
     virtual void initScene(GLfloat r, GLfloat g, GLfloat b, GLfloat opacity);
     virtual void renderScene(AminoNode *node);
 
+    bool hasPlayingVideos();
+
+    void setPartialRedraw(bool enabled);
+    void invalidateScene();
+    bool getDamageRect(GLint *rect);
+
     amino_atlas_t getAtlasTexture(texture_atlas_t *atlas, bool createIfMissing, bool &newTexture);
 
+    void getStats(v8::Local<v8::Object> &obj);
+    void setLayerBudget(size_t budget);
+    void removeLayer(AminoGroup *group);
+
     static int showGLErrors();
     static int showGLErrors(std::string msg);
 
     static void checkTexturePerformance();
 
 protected:
-    virtual void render(AminoNode *node);
+    virtual void render();
+    void renderCommands(std::size_t start, std::size_t end);
 
-    virtual void drawGroup(AminoGroup *group);
+    virtual void beginGroup(AminoGroup *group);
+    virtual void endGroup(AminoGroup *group);
     virtual void drawRect(AminoRect *rect);
     virtual void drawPoly(AminoPolygon *poly);
     virtual void drawModel(AminoModel *model);
     virtual void drawText(AminoText *text);
 
+    void uploadBuffer(GLenum target, GLsizeiptr size, const GLvoid *data, GLsizeiptr &bufferSize);
+    void uploadBufferRange(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data);
+
 private:
     AminoGfx *gfx;
 
     //basic shaders
     AminoFontShader *fontShader = NULL;
+    AminoSdfFontShader *sdfFontShader = NULL;
     ColorShader *colorShader = NULL;
     TextureShader *textureShader = NULL;
     TextureClampToBorderShader *textureClampToBorderShader = NULL;
@@ -306,6 +344,78 @@ private:
     ColorLightingShader *colorLightingShader = NULL;
     TextureLightingShader *textureLightingShader = NULL;
 
+    //batching (streaming VBO)
+    BatchColorShader *batchColorShader = NULL;
+    BatchTextureShader *batchTextureShader = NULL;
+    GLuint batchBuffer = INVALID_BUFFER;
+    std::vector<GLfloat> batchVertices;
+    int batchMode = BATCH_NONE;
+    GLuint batchTexture = INVALID_TEXTURE;
+    bool batchBlend = false;
+
+    //batching stats
+    int batchCount = 0;
+    int batchNodeCount = 0;
+    int lastBatchCount = 0;
+    int lastBatchNodeCount = 0;
+
+    //command list
+    std::vector<amino_render_cmd_t> commands;
+    std::vector<amino_render_cmd_t> recordBuffer;
+    AminoNode *lastRoot = NULL;
+    bool commandsValid = false;
+
+    //command list stats
+    int recordCount = 0;
+    int lastRecordCount = 0;
+    int rebuildCount = 0;
+    int matrixCount = 0;
+    int lastMatrixCount = 0;
+
+    //layers
+    std::map<AminoGroup *, amino_layer_t> layers;
+    size_t layerMemory = 0;
+    size_t layerBudget = LAYER_BUDGET;
+    int layerDepth = 0;
+    GLint maxTextureSize = 0;
+    GLfloat opacityFactor = 1;
+    std::vector<GLfloat> opacityStack;
+    int frameCount = 0;
+
+    //layer stats
+    int layerRenderCount = 0;
+    int lastLayerRenderCount = 0;
+
+    //buffer stats
+    size_t uploadBytes = 0;
+    size_t lastUploadBytes = 0;
+
+    //partial redraw
+    bool partialRedraw = false;
+    bool damageInvalid = true;
+    GLfloat frameDamage[4];
+    GLfloat damageHistory[DAMAGE_HISTORY][4];
+    int damageHistorySize = 0;
+    bool damageUsed = false;
+    GLfloat damageArea[4];
+    GLint damageRect[4] = { 0, 0, 0, 0 };
+
+    //partial redraw stats
+    int skippedFrames = 0;
+    double lastDamageRatio = 1;
+
+    //clipping
+    std::vector<amino_clip_t> clipStack;
+    bool scissorUsed = false;
+    GLint scissorRect[4] = { 0, 0, 0, 0 };
+    int stencilDepth = 0;
+
+    //clipping stats
+    int scissorCount = 0;
+    int stencilCount = 0;
+    int lastScissorCount = 0;
+    int lastStencilCount = 0;
+
     //perspective
     bool orthographic = true;
     float near = 150;
@@ -319,10 +429,44 @@ private:
 
     //matrix
     GLfloat modelView[16];
+    GLfloat viewportW = 0;
+    GLfloat viewportH = 0;
     GLContext *ctx = NULL;
 
+    void updateCommands(AminoNode *root);
+    bool updateChildCommands(AminoGroup *group);
+    bool rerecord(AminoNode *node);
+    void addDamage(std::size_t start, std::size_t end);
+    void addDamage(GLfloat *bounds);
+    void addFullDamage();
+    void addVideoDamage();
+    AminoTexture* getNodeTexture(AminoNode *node);
+    void updateDamageHistory();
+    void record(AminoNode *node, GLfloat *parentMatrix, bool parentChanged, GLfloat parentOpacity, GLfloat *clip, std::vector<amino_render_cmd_t> &list, size_t base);
+
+    bool getLocalBounds(AminoNode *node, GLfloat *box);
+    bool getVertexBounds(std::vector<float> &vertices, int dim, GLfloat *box);
+    bool getTextBounds(AminoText *text, GLfloat *box);
+    bool getScreenBounds(AminoNode *node, GLfloat *bounds);
+    void getTextOffset(AminoText *text, GLfloat &x, GLfloat &y);
+
+    bool getScissorRect(AminoGroup *group, GLint *rect);
+    void beginClipping(AminoGroup *group);
+    void endClipping(AminoGroup *group);
+    void drawStencil(AminoGroup *group);
+
+    bool drawLayer(AminoGroup *group, std::size_t start, std::size_t end);
+    bool createLayer(AminoGroup *group, int w, int h, amino_layer_t &layer);
+    void renderLayer(AminoGroup *group, amino_layer_t &layer, GLfloat *inverse, std::size_t start, std::size_t end);
+    void freeLayer(amino_layer_t &layer);
+    bool freeOldestLayer();
+    void applyBlendFunc();
+
+    void addBatchRect(int mode, GLuint texture, bool blend, GLfloat w, GLfloat h, GLfloat values[4], GLfloat uv[4]);
+    void flushBatch();
+
     void applyColorShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat color[4], GLenum mode = GL_TRIANGLES);
-    void applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat uv[][2], GLuint texId, GLfloat opacity, bool needsClampToBorder, bool repeatX, bool repeatY);
+    void applyTextureShader(GLfloat *verts, GLsizei dim, GLsizei count, GLfloat uv[][2], GLuint texId, GLfloat opacity, bool needsClampToBorder, bool repeatX, bool repeatY, bool premultiplied = false);
 };
 
 #endif
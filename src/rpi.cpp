@@ -517,6 +517,11 @@ void AminoGfxRPi::initRenderer() {
         assert(res == EGL_TRUE);
     }
 
+    //partial redraw
+    if (partialRedraw) {
+        initPartialRedraw();
+    }
+
     //input
     initInput();
 }
@@ -673,6 +678,65 @@ void AminoGfxRPi::renderingDone() {
     assert(res == EGL_TRUE);
 }
 
+/**
+ * Check how the back buffer content can be reused.
+ */
+void AminoGfxRPi::initPartialRedraw() {
+    const char *extensions = eglQueryString(display, EGL_EXTENSIONS);
+
+    if (extensions) {
+        if (strstr(extensions, "EGL_EXT_buffer_age") || strstr(extensions, "EGL_KHR_partial_update")) {
+            bufferAgeSupported = true;
+        }
+
+        if (strstr(extensions, "EGL_KHR_partial_update")) {
+            setDamageRegionKHR = (amino_egl_set_damage_region_t)eglGetProcAddress("eglSetDamageRegionKHR");
+        }
+    }
+
+    if (!bufferAgeSupported) {
+        //keep the last frame in the back buffer
+        //Note: fails if the config does not support EGL_SWAP_BEHAVIOR_PRESERVED_BIT (full redraw)
+        if (eglSurfaceAttrib(display, surface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_PRESERVED) == EGL_TRUE) {
+            bufferPreserved = true;
+        }
+    }
+
+    if (DEBUG_GLES) {
+        printf("partial redraw: buffer age=%s preserved=%s damage region=%s\n", bufferAgeSupported ? "true":"false", bufferPreserved ? "true":"false", setDamageRegionKHR ? "true":"false");
+    }
+}
+
+/**
+ * Get the age of the back buffer.
+ */
+int AminoGfxRPi::getBufferAge() {
+    if (bufferAgeSupported) {
+        EGLint age = 0;
+
+        if (eglQuerySurface(display, surface, EGL_BUFFER_AGE_EXT, &age) != EGL_TRUE) {
+            return 0;
+        }
+
+        return age;
+    }
+
+    return bufferPreserved ? 1:0;
+}
+
+/**
+ * Limit the updated back buffer region.
+ */
+void AminoGfxRPi::setDamageRegion(GLint *rect) {
+    if (!setDamageRegionKHR) {
+        return;
+    }
+
+    EGLint rects[4] = { rect[0], rect[1], rect[2], rect[3] };
+
+    setDamageRegionKHR(display, surface, rects, 1);
+}
+
 void AminoGfxRPi::handleSystemEvents() {
     //handle events
     processInputs();
@@ -885,14 +949,14 @@ void AminoGfxRPi::updateWindowTitle() {
 /**
  * Shared atlas texture has changed.
  */
-void AminoGfxRPi::atlasTextureHasChanged(texture_atlas_t *atlas) {
+void AminoGfxRPi::atlasTextureHasChanged(amino_atlas_page_t *page) {
     //check single instance case
     if (instanceCount == 1) {
         return;
     }
 
     //run on main thread
-    enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfxRPi::atlasTextureHasChangedHandler), NULL, atlas);
+    enqueueJSCallbackUpdate(static_cast<jsUpdateCallback>(&AminoGfxRPi::atlasTextureHasChangedHandler), NULL, page);
 }
 
 /**
@@ -900,14 +964,14 @@ void AminoGfxRPi::atlasTextureHasChanged(texture_atlas_t *atlas) {
  */
 void AminoGfxRPi::atlasTextureHasChangedHandler(JSCallbackUpdate *update) {
     AminoGfx *gfx = static_cast<AminoGfx *>(update->obj);
-    texture_atlas_t *atlas = (texture_atlas_t *)update->data;
+    amino_atlas_page_t *page = (amino_atlas_page_t *)update->data;
 
     for (auto const &item : instances) {
         if (gfx == item) {
             continue;
         }
 
-        static_cast<AminoGfxRPi *>(item)->updateAtlasTexture(atlas);
+        static_cast<AminoGfxRPi *>(item)->updateAtlasTexture(page);
     }
 }
 
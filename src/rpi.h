@@ -11,6 +11,14 @@
 #include <semaphore.h>
 #include <linux/input.h>
 
+//EGL_EXT_buffer_age
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
+//EGL_KHR_partial_update
+typedef EGLBoolean (EGLAPIENTRYP amino_egl_set_damage_region_t)(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects);
+
 class AminoGfxRPiFactory : public AminoJSObjectFactory {
 public:
     AminoGfxRPiFactory(Nan::FunctionCallback callback);
@@ -43,6 +51,11 @@ private:
     uint32_t screenW = 0;
     uint32_t screenH = 0;
 
+    //partial redraw
+    bool bufferAgeSupported = false;
+    bool bufferPreserved = false;
+    amino_egl_set_damage_region_t setDamageRegionKHR = NULL;
+
     //resolution
     static sem_t resSem;
     static bool resSemValid;
@@ -76,6 +89,9 @@ private:
     void start() override;
     bool bindContext() override;
     void renderingDone() override;
+    void initPartialRedraw();
+    int getBufferAge() override;
+    void setDamageRegion(GLint *rect) override;
     void handleSystemEvents() override;
 
     void processInputs();
@@ -86,7 +102,7 @@ private:
     void updateWindowPosition() override;
     void updateWindowTitle() override;
 
-    void atlasTextureHasChanged(texture_atlas_t *atlas) override;
+    void atlasTextureHasChanged(amino_atlas_page_t *page) override;
     void atlasTextureHasChangedHandler(JSCallbackUpdate *update);
 
     AminoVideoPlayer *createVideoPlayer(AminoTexture *texture, AminoVideo *video) override;
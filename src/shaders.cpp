@@ -112,7 +112,14 @@ GLuint AnyShader::compileShader(std::string source, const GLenum type) {
         return -1;
     }
 
-#ifdef RPI
+#ifdef HEADLESS
+    //Mesa needs a default float precision in fragment shaders
+    if (type == GL_FRAGMENT_SHADER) {
+        source = "precision mediump float;\n" + source;
+    }
+#endif
+
+#if defined(RPI) || defined(HEADLESS)
     //add GLSL version
     source = "#version 100\n" + source;
 #endif
@@ -610,6 +617,158 @@ void TextureClampToBorderShader::setRepeat(bool repeatX, bool repeatY) {
     glUniform2i(uRepeat, repeatX, repeatY);
 }
 
+//
+// BatchColorShader
+//
+
+/**
+ * Create batched color shader.
+ */
+BatchColorShader::BatchColorShader() : AnyAminoShader() {
+    //Note: vertices are already in world coordinates
+    vertexShader = R"(
+        uniform mat4 mvp;
+
+        attribute vec4 pos;
+        attribute vec4 color;
+
+        varying vec4 vColor;
+
+        void main() {
+            gl_Position = mvp * pos;
+            vColor = color;
+        }
+    )";
+
+    fragmentShader = R"(
+        varying vec4 vColor;
+
+        void main() {
+            gl_FragColor = vColor;
+        }
+    )";
+}
+
+/**
+ * Initialize the batched color shader.
+ */
+void BatchColorShader::initShader() {
+    AnyAminoShader::initShader();
+
+    //attributes
+    aColor = getAttributeLocation("color");
+}
+
+/**
+ * Set interleaved vertex data (from bound VBO).
+ */
+void BatchColorShader::setBatchData() {
+    GLsizei stride = STRIDE * sizeof(GLfloat);
+
+    glVertexAttribPointer(aPos, 4, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    glVertexAttribPointer(aColor, 4, GL_FLOAT, GL_FALSE, stride, (void *)(4 * sizeof(GLfloat)));
+}
+
+/**
+ * Draw triangles.
+ */
+void BatchColorShader::drawTriangles(GLsizei vertices, GLenum mode) {
+    glEnableVertexAttribArray(aColor);
+
+    AnyAminoShader::drawTriangles(vertices, mode);
+
+    glDisableVertexAttribArray(aColor);
+}
+
+//
+// BatchTextureShader
+//
+
+/**
+ * Create batched texture shader.
+ */
+BatchTextureShader::BatchTextureShader() : AnyAminoShader() {
+    //Note: vertices are already in world coordinates
+    vertexShader = R"(
+        uniform mat4 mvp;
+
+        attribute vec4 pos;
+        attribute vec2 texCoord;
+        attribute float opacity;
+
+        varying vec2 uv;
+        varying float vOpacity;
+
+        void main() {
+            gl_Position = mvp * pos;
+            uv = texCoord;
+            vOpacity = opacity;
+        }
+    )";
+
+    //same output as TextureShader
+    fragmentShader = R"(
+        varying vec2 uv;
+        varying float vOpacity;
+
+        uniform sampler2D tex;
+
+        void main() {
+            vec4 pixel = texture2D(tex, uv);
+
+            //discard transparent pixels
+            if (pixel.a == 0.) {
+                discard;
+            }
+
+            gl_FragColor = vec4(pixel.rgb, pixel.a * vOpacity);
+        }
+    )";
+}
+
+/**
+ * Initialize the batched texture shader.
+ */
+void BatchTextureShader::initShader() {
+    AnyAminoShader::initShader();
+
+    //attributes
+    aTexCoord = getAttributeLocation("texCoord");
+    aOpacity = getAttributeLocation("opacity");
+
+    //uniforms
+    uTex = getUniformLocation("tex");
+
+    //default values
+    glUniform1i(uTex, 0); //GL_TEXTURE0
+}
+
+/**
+ * Set interleaved vertex data (from bound VBO).
+ */
+void BatchTextureShader::setBatchData() {
+    GLsizei stride = STRIDE * sizeof(GLfloat);
+
+    glVertexAttribPointer(aPos, 4, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    glVertexAttribPointer(aTexCoord, 2, GL_FLOAT, GL_FALSE, stride, (void *)(4 * sizeof(GLfloat)));
+    glVertexAttribPointer(aOpacity, 1, GL_FLOAT, GL_FALSE, stride, (void *)(6 * sizeof(GLfloat)));
+}
+
+/**
+ * Draw triangles.
+ */
+void BatchTextureShader::drawTriangles(GLsizei vertices, GLenum mode) {
+    glEnableVertexAttribArray(aTexCoord);
+    glEnableVertexAttribArray(aOpacity);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    AnyAminoShader::drawTriangles(vertices, mode);
+
+    glDisableVertexAttribArray(aTexCoord);
+    glDisableVertexAttribArray(aOpacity);
+}
+
 //
 // TextureLightingShader
 //
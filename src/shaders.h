@@ -143,6 +143,54 @@ protected:
     void initShader() override;
 };
 
+/**
+ * Batched color shader.
+ *
+ * Vertices are pre-transformed and carry their own color (interleaved: x, y, z, w, r, g, b, a).
+ */
+class BatchColorShader : public AnyAminoShader {
+public:
+    static const GLsizei STRIDE = 8;
+
+    BatchColorShader();
+
+    //per vertex data (bound VBO)
+    void setBatchData();
+
+    //draw
+    void drawTriangles(GLsizei vertices, GLenum mode) override;
+
+protected:
+    GLint aColor;
+
+    void initShader() override;
+};
+
+/**
+ * Batched texture shader.
+ *
+ * Vertices are pre-transformed and carry their own opacity (interleaved: x, y, z, w, u, v, opacity).
+ */
+class BatchTextureShader : public AnyAminoShader {
+public:
+    static const GLsizei STRIDE = 7;
+
+    BatchTextureShader();
+
+    //per vertex data (bound VBO)
+    void setBatchData();
+
+    //draw
+    void drawTriangles(GLsizei vertices, GLenum mode) override;
+
+protected:
+    GLint aTexCoord;
+    GLint aOpacity;
+    GLint uTex;
+
+    void initShader() override;
+};
+
 /**
  * Texture Lighting Shader.
  */